@@ -60,11 +60,10 @@ namespace Light
                 //绘制组件标题
                 ImGui::SeparatorText(componentName);
                 //绘制组件内容
-                auto result = Type::indexToType.find(componentType);
-                if (result != Type::indexToType.end())
+                const Type* type = Type::GetType(componentType);
+                if (type != nullptr)
                 {
                     EditorUISerializer editorUiSerializer;
-                    Type* type = result->second;
                     type->serialize(editorUiSerializer, component);
                 }
             }
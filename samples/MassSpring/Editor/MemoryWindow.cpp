@@ -0,0 +1,87 @@
+#include "MemoryWindow.h"
+#include "LightUI/Runtime/UI.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
+
+namespace Light
+{
+    static std::string FormatBytes(const size_t bytes)
+    {
+        if (bytes >= 1024 * 1024)
+            return std::format("{:.2f}MB", static_cast<double>(bytes) / (1024 * 1024));
+        if (bytes >= 1024)
+            return std::format("{:.2f}KB", static_cast<double>(bytes) / 1024);
+        return std::format("{}B", bytes);
+    }
+
+    void MemoryWindow::Update()
+    {
+        ImGui::Begin("MemoryWindow");
+
+        ImGui::SeparatorText("Statistics");
+        const MemoryStatistics total = MemoryTracker::GetTotalStatistics();
+        ImGui::BulletText(std::format("Current:{} Peak:{}", FormatBytes(total.currentBytes), FormatBytes(total.peakBytes)).c_str());
+        ImGui::BulletText(std::format("FrameAllocation:{} ({})", total.frameAllocationCount, FormatBytes(total.frameAllocatedBytes)).c_str());
+
+        ImGui::SeparatorText("Details");
+        if (ImGui::BeginTable("Tags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Current");
+            ImGui::TableSetupColumn("Peak");
+            ImGui::TableSetupColumn("Allocation");
+            ImGui::TableSetupColumn("FrameAllocation");
+            ImGui::TableHeadersRow();
+            for (int i = 0; i < static_cast<int>(MemoryTag::Count); i++)
+            {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                const MemoryStatistics statistics = MemoryTracker::GetStatistics(tag);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(statistics.currentBytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(statistics.peakBytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", statistics.allocationCount);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu (%s)", statistics.frameAllocationCount, FormatBytes(statistics.frameAllocatedBytes).c_str());
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::CollapsingHeader("History"))
+        {
+            for (int i = 0; i < static_cast<int>(MemoryTag::Count); i++)
+            {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                const std::array history = MemoryTracker::GetHistory(tag);
+                ImGui::PlotLines(MemoryTracker::GetTagName(tag), history.data(), static_cast<int>(history.size()),
+                                 0, nullptr, 0, FLT_MAX, ImVec2(0, 40));
+            }
+        }
+        if (ImGui::CollapsingHeader("CallSite"))
+        {
+            bool isCapturing = MemoryTracker::IsCapturingCallSites();
+            if (ImGui::Checkbox("Capture", &isCapturing))
+                MemoryTracker::SetCallSiteCapture(isCapturing);
+
+            for (const MemoryCallSite& callSite : MemoryTracker::GetCallSites())
+            {
+                //未处于任何调用点作用域中的分配
+                if (callSite.file.empty())
+                {
+                    ImGui::BulletText("%s", std::format("[{}] Unmarked Count:{} Size:{}",
+                                                  MemoryTracker::GetTagName(callSite.tag),
+                                                  callSite.allocationCount, FormatBytes(callSite.allocatedBytes)).c_str());
+                    continue;
+                }
+                ImGui::BulletText("%s", std::format("[{}] {}:{} Count:{} Size:{}",
+                                              MemoryTracker::GetTagName(callSite.tag), callSite.file, callSite.line,
+                                              callSite.allocationCount, FormatBytes(callSite.allocatedBytes)).c_str());
+            }
+        }
+
+        ImGui::End();
+    }
+}
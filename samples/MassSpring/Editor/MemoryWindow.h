@@ -0,0 +1,18 @@
+#pragma once
+#include "../Public/UISystem.h"
+#include "LightECS/Runtime/System.h"
+
+namespace Light
+{
+    class MemoryWindow : public System
+    {
+    public:
+        MemoryWindow(): System(&UISystem)
+        {
+        }
+
+    private:
+        void Update() override;
+    };
+    inline MemoryWindow MemoryWindow = {};
+}
@@ -5,6 +5,7 @@
 #include "LightWindow/Runtime/Input.h"
 #include "LightWindow/Runtime/Window.h"
 #include "LightECS/Runtime/View.hpp"
+#include "LightUtility/Runtime/FrameArena.h"
 #include "LightWindow/Runtime/Time.h"
 
 #include "Public/Component.hpp"
@@ -45,13 +46,12 @@ void LogicSystem::OnCreatePoint() const
     }
 }
 
-std::vector<Entity> lines;
 void LogicSystem::OnDeletePoint()
 {
     if (Input::GetMouseButtonDown(MouseButton::Left) && coveringPoint != Entity::Null)
     {
-        lines.clear();
-        View<SpringPhysics>::Each([this](const Entity entity, SpringPhysics& springPhysics)
+        std::pmr::vector<Entity> lines(&FrameArena::GetResource());
+        View<SpringPhysics>::Each([this,&lines](const Entity entity, SpringPhysics& springPhysics)
         {
             if (springPhysics.pointA == coveringPoint || springPhysics.pointB == coveringPoint)
                 lines.push_back(entity);
@@ -1,33 +1,49 @@
 ﻿#include "ForceSystem.h"
 
 #include "PhysicsComponent.hpp"
+#include "../Archetype.hpp"
 #include "LightECS/Runtime/View.hpp"
 #include "LightMath/Runtime/VectorMath.hpp"
 #include "../Public/Component.hpp"
 
 void Light::ForceSystem::Update()
 {
-    //弹力
-    View<SpringPhysics>::Each([](SpringPhysics& springPhysics)
+    //弹力（基于编译后的弹簧拓扑，通过稠密索引直接访问质点）
+    if (springTopology.IsDirty())
+        springTopology.Rebuild();
+
+    Heap* springHeap = World::GetEntityHeap(SpringArchetype);
+    Heap* pointHeap = World::GetEntityHeap(MassPointArchetype);
+    if (springHeap != nullptr && pointHeap != nullptr)
     {
-        Point* pointA;
-        MassPointPhysics* massPointPhysicsA;
-        springPhysics.pointA.Get(&pointA, &massPointPhysicsA);
-        Point* pointB;
-        MassPointPhysics* massPointPhysicsB;
-        springPhysics.pointB.Get(&pointB, &massPointPhysicsB);
+        const std::vector<SpringTopology::Edge>& edges = springTopology.GetEdges();
+        const int springOffset = SpringArchetype.GetOffset(typeid(SpringPhysics));
+        const int pointOffset = MassPointArchetype.GetOffset(typeid(Point));
+        const int massPointPhysicsOffset = MassPointArchetype.GetOffset(typeid(MassPointPhysics));
+        int springIndex = 0;
+        springHeap->ForeachElements([&](std::byte* item)
+        {
+            const SpringPhysics& springPhysics = *reinterpret_cast<SpringPhysics*>(item + springOffset);
+            const SpringTopology::Edge& edge = edges[springIndex++];
+            std::byte* massPointA = pointHeap->At(edge.pointA);
+            std::byte* massPointB = pointHeap->At(edge.pointB);
+            Point* pointA = reinterpret_cast<Point*>(massPointA + pointOffset);
+            MassPointPhysics* massPointPhysicsA = reinterpret_cast<MassPointPhysics*>(massPointA + massPointPhysicsOffset);
+            Point* pointB = reinterpret_cast<Point*>(massPointB + pointOffset);
+            MassPointPhysics* massPointPhysicsB = reinterpret_cast<MassPointPhysics*>(massPointB + massPointPhysicsOffset);
 
-        float2 elasticityVector_BToA = pointA->position - pointB->position;
-        float2 elasticityDirection_BToA = normalize(elasticityVector_BToA);
-        float2 elasticityMagnitude_BToA = length(elasticityVector_BToA);
-        float2 elasticityBToA = springPhysics.elasticity * elasticityDirection_BToA * (elasticityMagnitude_BToA - springPhysics.length);
+            float2 elasticityVector_BToA = pointA->position - pointB->position;
+            float2 elasticityDirection_BToA = normalize(elasticityVector_BToA);
+            float2 elasticityMagnitude_BToA = length(elasticityVector_BToA);
+            float2 elasticityBToA = springPhysics.elasticity * elasticityDirection_BToA * (elasticityMagnitude_BToA - springPhysics.length);
 
-        float2 velocity_BToA = massPointPhysicsA->velocity - massPointPhysicsB->velocity;
-        float2 resistance_BToA = -springPhysics.resistance * elasticityDirection_BToA * dot(-velocity_BToA, elasticityDirection_BToA);
+            float2 velocity_BToA = massPointPhysicsA->velocity - massPointPhysicsB->velocity;
+            float2 resistance_BToA = -springPhysics.resistance * elasticityDirection_BToA * dot(-velocity_BToA, elasticityDirection_BToA);
 
-        massPointPhysicsB->force += elasticityBToA + resistance_BToA;
-        massPointPhysicsA->force -= elasticityBToA + resistance_BToA;
-    });
+            massPointPhysicsB->force += elasticityBToA + resistance_BToA;
+            massPointPhysicsA->force -= elasticityBToA + resistance_BToA;
+        });
+    }
 
     //重力
     View<MassPointPhysics>::Each([](MassPointPhysics& massPointPhysics)
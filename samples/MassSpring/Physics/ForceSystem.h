@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "PhysicsSystem.h"
+#include "SpringTopology.h"
 #include "LightECS/Runtime/System.h"
 
 namespace Light
@@ -11,7 +12,12 @@ namespace Light
         {
         }
 
+        SpringTopology& GetSpringTopology() { return springTopology; }
+
         void Update() override;
+
+    private:
+        SpringTopology springTopology;
     };
     inline ForceSystem ForceSystem = {};
 }
@@ -14,7 +14,7 @@ namespace Light
         float drag = 0.99f;
     };
 
-    MakeType("", MassPointPhysics)
+    MakeType("C168402D-CF54-48DE-B96B-E786030F00BA", MassPointPhysics)
     {
         MakeType_AddField(force);
         MakeType_AddField(velocity);
@@ -32,7 +32,7 @@ namespace Light
     };
 
     
-    MakeType("", SpringPhysics)
+    MakeType("B727AC02-9461-497A-B27D-A9597C9471B2", SpringPhysics)
     {
         MakeType_AddField(pointA);
         MakeType_AddField(pointB);
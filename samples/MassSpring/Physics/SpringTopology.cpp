@@ -0,0 +1,147 @@
+﻿#include "SpringTopology.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "PhysicsComponent.hpp"
+#include "../Archetype.hpp"
+#include "LightECS/Runtime/World.h"
+
+namespace Light
+{
+    int SpringTopology::GetBandwidth() const
+    {
+        int bandwidth = 0;
+        for (const Edge& edge : edges)
+            bandwidth = std::max(bandwidth, std::abs(edge.pointA - edge.pointB));
+        return bandwidth;
+    }
+
+    bool SpringTopology::IsDirty() const
+    {
+        return isBuilt == false || builtVersion != World::GetStructureVersion();
+    }
+    void SpringTopology::Rebuild()
+    {
+        edges.clear();
+        adjacencyOffsets.clear();
+        adjacencies.clear();
+        isBuilt = true;
+        builtVersion = World::GetStructureVersion();
+
+        Heap* pointHeap = World::GetEntityHeap(MassPointArchetype);
+        Heap* springHeap = World::GetEntityHeap(SpringArchetype);
+        const int pointCount = pointHeap == nullptr ? 0 : pointHeap->GetCount();
+        const int springCount = springHeap == nullptr ? 0 : springHeap->GetCount();
+        if (pointCount == 0)
+            return;
+
+        //收集弹簧两端质点的稠密索引
+        std::vector<Edge> springEdges(springCount);
+        if (springCount != 0)
+        {
+            const int springOffset = SpringArchetype.GetOffset(typeid(SpringPhysics));
+            springHeap->ForeachElements(0, springCount, [&springEdges,springOffset](const int itemIndex, std::byte* item)
+            {
+                const SpringPhysics& springPhysics = *reinterpret_cast<SpringPhysics*>(item + springOffset);
+                const EntityInfo pointA = World::GetEntityInfo(springPhysics.pointA);
+                const EntityInfo pointB = World::GetEntityInfo(springPhysics.pointB);
+                assert(pointA.archetype == &MassPointArchetype && pointB.archetype == &MassPointArchetype && "弹簧只能连接质点！");
+                springEdges[itemIndex] = {pointA.indexAtHeap, pointB.indexAtHeap};
+            });
+        }
+
+        //按逆Cuthill-McKee排序重排质点，使相连的质点彼此靠近
+        BuildAdjacency(pointCount, springEdges, adjacencyOffsets, adjacencies);
+        const std::vector<int> pointOrder = ReverseCuthillMcKee(adjacencyOffsets, adjacencies);
+        World::ReorderEntities(MassPointArchetype, pointOrder);
+
+        std::vector<int> newPointIndices(pointCount);
+        for (int i = 0; i < pointCount; i++)
+            newPointIndices[pointOrder[i]] = i;
+        for (Edge& edge : springEdges)
+            edge = {newPointIndices[edge.pointA], newPointIndices[edge.pointB]};
+
+        //按端点顺序重排弹簧，使遍历弹簧时对质点的访问大致是顺序的
+        std::vector<int> springOrder(springCount);
+        std::iota(springOrder.begin(), springOrder.end(), 0);
+        std::ranges::sort(springOrder, [&springEdges](const int left, const int right)
+        {
+            const Edge& a = springEdges[left];
+            const Edge& b = springEdges[right];
+            const int minA = std::min(a.pointA, a.pointB);
+            const int minB = std::min(b.pointA, b.pointB);
+            if (minA != minB)
+                return minA < minB;
+            return std::max(a.pointA, a.pointB) < std::max(b.pointA, b.pointB);
+        });
+        if (springCount != 0)
+            World::ReorderEntities(SpringArchetype, springOrder);
+
+        edges.resize(springCount);
+        for (int i = 0; i < springCount; i++)
+            edges[i] = springEdges[springOrder[i]];
+        BuildAdjacency(pointCount, edges, adjacencyOffsets, adjacencies);
+    }
+
+    std::vector<int> SpringTopology::ReverseCuthillMcKee(const std::vector<int>& adjacencyOffsets, const std::vector<int>& adjacencies)
+    {
+        const int count = static_cast<int>(adjacencyOffsets.size()) - 1;
+        auto degree = [&adjacencyOffsets](const int node) { return adjacencyOffsets[node + 1] - adjacencyOffsets[node]; };
+
+        //各连通分量从度最小的节点开始，广度优先遍历，并按度从小到大加入相邻节点
+        std::vector<int> order;
+        order.reserve(count);
+        std::vector<bool> visited(count, false);
+        std::vector<int> nodesByDegree(count);
+        std::iota(nodesByDegree.begin(), nodesByDegree.end(), 0);
+        std::ranges::stable_sort(nodesByDegree, [&degree](const int a, const int b) { return degree(a) < degree(b); });
+        std::vector<int> neighbors;
+        for (const int start : nodesByDegree)
+        {
+            if (visited[start])
+                continue;
+
+            visited[start] = true;
+            size_t head = order.size();
+            order.push_back(start);
+            while (head < order.size())
+            {
+                const int node = order[head++];
+                neighbors.assign(adjacencies.begin() + adjacencyOffsets[node], adjacencies.begin() + adjacencyOffsets[node + 1]);
+                std::ranges::stable_sort(neighbors, [&degree](const int a, const int b) { return degree(a) < degree(b); });
+                for (const int neighbor : neighbors)
+                {
+                    if (visited[neighbor])
+                        continue;
+                    visited[neighbor] = true;
+                    order.push_back(neighbor);
+                }
+            }
+        }
+
+        std::ranges::reverse(order);
+        return order;
+    }
+    void SpringTopology::BuildAdjacency(const int pointCount, const std::vector<Edge>& edges, std::vector<int>& adjacencyOffsets, std::vector<int>& adjacencies)
+    {
+        //统计各质点的度，再通过前缀和得到行偏移
+        adjacencyOffsets.assign(pointCount + 1, 0);
+        for (const Edge& edge : edges)
+        {
+            adjacencyOffsets[edge.pointA + 1]++;
+            adjacencyOffsets[edge.pointB + 1]++;
+        }
+        for (int i = 0; i < pointCount; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+        adjacencies.resize(adjacencyOffsets[pointCount]);
+        std::vector<int> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (const Edge& edge : edges)
+        {
+            adjacencies[cursors[edge.pointA]++] = edge.pointB;
+            adjacencies[cursors[edge.pointB]++] = edge.pointA;
+        }
+    }
+}
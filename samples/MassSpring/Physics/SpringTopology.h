@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Light
+{
+    /**
+     * @brief 编译后的弹簧拓扑
+     *
+     * 弹簧组件通过两个实体引用连接质点，且按创建顺序存放，因此遍历弹簧时对端点的访问在内存中是跳跃的。<br/>
+     * 该结构将弹簧的连接关系编译为基于质点稠密索引（即质点在实体堆中的位置）的边表和CSR邻接表，
+     * 并利用逆Cuthill-McKee排序重排质点堆，使相连的质点在内存中彼此靠近，同时按端点顺序重排弹簧堆，使边表与弹簧堆一一对应。
+     */
+    class SpringTopology
+    {
+    public:
+        struct Edge
+        {
+            int pointA;
+            int pointB;
+        };
+
+        /**
+         * 与弹簧堆顺序一一对应的边表，即第i条边描述了弹簧堆中第i个弹簧所连接的两个质点
+         * @return
+         */
+        const std::vector<Edge>& GetEdges() const { return edges; }
+        /**
+         * CSR邻接表的行偏移，质点i的相邻质点为 adjacencies[adjacencyOffsets[i]] 到 adjacencies[adjacencyOffsets[i+1]-1]
+         * @return
+         */
+        const std::vector<int>& GetAdjacencyOffsets() const { return adjacencyOffsets; }
+        const std::vector<int>& GetAdjacencies() const { return adjacencies; }
+        /**
+         * 邻接矩阵的带宽，即相连质点稠密索引之差的最大值，越小说明相连的质点在内存中越接近
+         * @return
+         */
+        int GetBandwidth() const;
+
+        /**
+         * 实体结构发生变化后（如增删质点或弹簧），拓扑数据将过期，需要重新编译
+         * @return
+         */
+        bool IsDirty() const;
+        /**
+         * 重新编译拓扑
+         * @note 会重排质点堆及弹簧堆，但不会改变实体本身，因此实体引用依然有效
+         */
+        void Rebuild();
+
+        /**
+         * 计算逆Cuthill-McKee排序
+         * @param adjacencyOffsets CSR邻接表的行偏移
+         * @param adjacencies CSR邻接表的列索引
+         * @return 排序后第i个位置的节点在排序前的索引
+         */
+        static std::vector<int> ReverseCuthillMcKee(const std::vector<int>& adjacencyOffsets, const std::vector<int>& adjacencies);
+        static void BuildAdjacency(int pointCount, const std::vector<Edge>& edges, std::vector<int>& adjacencyOffsets, std::vector<int>& adjacencies);
+
+    private:
+        bool isBuilt = false;
+        uint32_t builtVersion = 0;
+        std::vector<Edge> edges;
+        std::vector<int> adjacencyOffsets;
+        std::vector<int> adjacencies;
+    };
+}
@@ -9,7 +9,7 @@ namespace Light
         float2 position;
     };
 
-    MakeType("", Point)
+    MakeType("72144EAC-90FF-4F8A-8EFF-786E936A2EE8", Point)
     {
         MakeType_AddField(position);
     }
@@ -20,7 +20,7 @@ namespace Light
         float2 positionB;
     };
 
-    MakeType("", Line)
+    MakeType("BE78E71B-ED68-4C1B-A2CB-39908659512F", Line)
     {
         MakeType_AddField(positionA);
         MakeType_AddField(positionB);
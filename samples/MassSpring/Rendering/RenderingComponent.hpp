@@ -9,7 +9,7 @@ namespace Light
         float4 color = 1;
     };
 
-    MakeType("", Renderer)
+    MakeType("8B3C672A-0B76-48A1-BF2A-A27E9467B1BC", Renderer)
     {
         MakeType_AddField(color);
     }
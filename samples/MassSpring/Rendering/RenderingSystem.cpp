@@ -32,8 +32,8 @@ namespace Light
 
     void RenderingSystem::DrawObject() const
     {
-        std::vector<Vertex>& pointVertices = pointMesh->GetVertices();
-        std::vector<uint32_t>& pointIndices = pointMesh->GetIndices();
+        auto& pointVertices = pointMesh->GetVertices();
+        auto& pointIndices = pointMesh->GetIndices();
         pointVertices.clear();
         pointIndices.clear();
         int pointIndex = 0;
@@ -44,8 +44,8 @@ namespace Light
         });
         pointMesh->SetDirty();
 
-        std::vector<Vertex>& lineVertices = lineMesh->GetVertices();
-        std::vector<uint32_t>& lineIndices = lineMesh->GetIndices();
+        auto& lineVertices = lineMesh->GetVertices();
+        auto& lineIndices = lineMesh->GetIndices();
         lineVertices.clear();
         lineIndices.clear();
         int lineIndex = 0;
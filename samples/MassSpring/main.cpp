@@ -6,10 +6,16 @@
 #include "Editor/GameWindow.h"
 #include "Editor/HierarchyWindow.h"
 #include "Editor/InspectorWindow.h"
+#include "Editor/MemoryWindow.h"
 #include "LightECS/Runtime/World.h"
 #include "LightGL/Runtime/GL.h"
 #include "LightGraphics/Runtime/Graphics.h"
 #include "LightUI/Runtime/UI.h"
+#include "LightUtility/Runtime/FrameArena.h"
+#include "LightUtility/Runtime/Logger.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
+#include "LightUtility/Runtime/Profiler.h"
+#include "LightUtility/Runtime/Task.h"
 #include "LightWindow/Runtime/Window.h"
 #include "Physics/CollisionSystem.h"
 #include "Physics/ForceSystem.h"
@@ -20,6 +26,10 @@ using namespace Light;
 
 int main()
 {
+    Logger::InstallCrashHandler();
+    Logger::SetFileOutput("MassSpring.log");
+    LIGHT_LOG_INFO(GeneralLog, "MassSpring启动");
+
     Window window = Window::Initialize("MassSpring", static_cast<int>(1920 * 0.7f), static_cast<int>(1080 * 0.7f), false);
     std::vector<const char*> extensions;
     Graphics::InitializeGLDemand(extensions);
@@ -28,7 +38,7 @@ int main()
     UI::Initialize(window, graphics);
 
     static std::initializer_list<System*> gameLogics = {&FixedPointSystem, &LineUpdateSystem, &LogicSystem};
-    static std::initializer_list<System*> editorWindows = {&GameWindow, &GameWindowAssetsSystem, &HierarchyWindow, &InspectorWindow};
+    static std::initializer_list<System*> editorWindows = {&GameWindow, &GameWindowAssetsSystem, &HierarchyWindow, &MemoryWindow, &InspectorWindow};
 
     Window::SetWindowStartEvent([]
     {
@@ -70,6 +80,10 @@ int main()
     Window::SetWindowUpdateEvent([]()
     {
         World::Update();
+        Coroutine::RunMainThread();
+        FrameArena::EndFrame();
+        MemoryTracker::EndFrame();
+        LIGHT_PROFILE_FRAME();
     });
     Window::SetWindowStopEvent([]
     {
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <format>
+#include <algorithm>
 #include <array>
 #include <string>
 #include <typeindex>
@@ -41,11 +42,18 @@ namespace Light
             archetype->componentTypes = {typeid(TComponents)...};
             archetype->componentSizes = {sizeof(TComponents)...};
             archetype->componentOffsets.resize(sizeof...(TComponents));
+            //组件偏移需满足各自的对齐要求（如使用SIMD的float4），整体大小也要对齐到最大对齐值，以保证堆中连续存放的每个实体都是对齐的
+            constexpr int componentAlignments[] = {alignof(TComponents)...};
             for (int i = 1; i < sizeof...(TComponents); ++i)
-                archetype->componentOffsets[i] = archetype->componentOffsets[i - 1] + archetype->componentSizes[i - 1];
+            {
+                const int offset = archetype->componentOffsets[i - 1] + archetype->componentSizes[i - 1];
+                archetype->componentOffsets[i] = (offset + componentAlignments[i] - 1) / componentAlignments[i] * componentAlignments[i];
+            }
             archetype->constructors = {ArchetypeComponentOperator<TComponents>::Constructor...};
             archetype->destructors = {ArchetypeComponentOperator<TComponents>::Destructor...};
-            archetype->size = archetype->componentOffsets[sizeof...(TComponents) - 1] + archetype->componentSizes[sizeof...(TComponents) - 1];
+            constexpr int alignment = std::max({alignof(TComponents)...});
+            const size_t size = archetype->componentOffsets[sizeof...(TComponents) - 1] + archetype->componentSizes[sizeof...(TComponents) - 1];
+            archetype->size = (size + alignment - 1) / alignment * alignment;
             for (int i = 0; i < sizeof...(TComponents); i++)
                 archetype->componentOffsetsMap.insert({archetype->componentTypes[i], archetype->componentOffsets[i]});
 
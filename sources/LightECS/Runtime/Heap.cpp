@@ -8,21 +8,10 @@ namespace Light
     {
     }
     
-    void Heap::AddElement(const std::function<void(std::byte* address)>& setValue)
-    {
-        elementCount += 1;
-        ResizeHeaps();
-
-        if (setValue != nullptr)
-            setValue(At(elementCount - 1));
-    }
-    void Heap::AddElements(const int count, const std::function<void(int number, std::byte* address)>& setValue)
+    void Heap::AddElements(const int count)
     {
         elementCount += count;
         ResizeHeaps();
-
-        if (setValue != nullptr)
-            ForeachElements(elementCount - count, count, setValue);
     }
     
     std::byte* Heap::RemoveElement(const int index)
@@ -47,33 +36,6 @@ namespace Light
         ResizeHeaps();
     }
     
-    void Heap::ForeachElements(const int index, int count, const std::function<void(int itemIndex, std::byte* item)>& iterator) const
-    {
-        int heapIndex;
-        int heapElementIndex;
-        GetHeapIndex(index, &heapIndex, &heapElementIndex);
-
-        int foreachIndex = 0;
-        while (true)
-        {
-            //获取遍历地址和最大遍历次数
-            std::byte* headAddress = heaps[heapIndex].get() + heapElementIndex * elementSize;
-            int sequentialElementCount = chunkElementCount - heapElementIndex;
-            int foreachCount = std::min(count, sequentialElementCount);
-            //遍历元素
-            for (int i = 0; i < foreachCount; i++)
-            {
-                iterator(foreachIndex, headAddress + i * elementSize);
-                foreachIndex++;
-            }
-            //完成一次遍历
-            count -= sequentialElementCount;
-            if (count <= 0)
-                break;
-            //获取下次遍历的信息
-            GetHeapIndex(index + sequentialElementCount, &heapIndex, &heapElementIndex);
-        }
-    }
     std::byte* Heap::At(const int index) const
     {
         int heapIndex;
@@ -103,13 +65,12 @@ namespace Light
         else if (heaps.size() < occupiedChunkCount) //容量不足必须块数，触发扩容
         {
             //扩容块数量到最佳块数
+            const size_t chunkSize = elementSize * chunkElementCount;
             for (size_t i = expectedChunkCount - heaps.size(); i > 0; i--)
-                heaps.emplace_back(new std::byte[elementSize * chunkElementCount]);
+            {
+                heaps.emplace_back(new std::byte[chunkSize], ChunkDeleter{chunkSize});
+                MemoryTracker::RecordAllocation(MemoryTag::ECS, chunkSize);
+            }
         }
     }
-    void Heap::GetHeapIndex(const int elementIndex, int* heapIndex, int* heapElementIndex) const
-    {
-        *heapIndex = elementIndex / chunkElementCount;
-        *heapElementIndex = elementIndex % chunkElementCount;
-    }
 }
@@ -1,8 +1,10 @@
 ﻿#pragma once
-#include <functional>
+#include <algorithm>
 #include <vector>
 #include <memory>
 
+#include "LightUtility/Runtime/MemoryTracker.h"
+
 namespace Light
 {
     /**
@@ -15,9 +17,31 @@ namespace Light
         Heap(size_t elementSize, int chunkElementCount = 64, int spareChunkCount = 1);
 
         int GetCount() const { return elementCount; }
+        size_t GetElementSize() const { return elementSize; }
 
-        void AddElement(const std::function<void(std::byte* item)>& setValue);
-        void AddElements(int count, const std::function<void(int itemIndex, std::byte* item)>& setValue = nullptr);
+        /**
+         * 添加一个元素
+         * @param setValue 参数为新元素的地址，用于初始化元素
+         */
+        template <typename TSetter> requires requires(TSetter setValue, std::byte* ptr) { setValue(ptr); }
+        void AddElement(TSetter setValue)
+        {
+            elementCount += 1;
+            ResizeHeaps();
+            setValue(At(elementCount - 1));
+        }
+        void AddElements(int count);
+        /**
+         * 添加多个元素
+         * @param count
+         * @param setValue 参数为元素在新增元素中的序号和地址，用于初始化元素
+         */
+        template <typename TSetter> requires requires(TSetter setValue, std::byte* ptr) { setValue(0, ptr); }
+        void AddElements(const int count, TSetter setValue)
+        {
+            AddElements(count);
+            ForeachElements(elementCount - count, count, setValue);
+        }
 
         /**
      * 删除目标位置的元素并移动末尾的元素来填补空缺
@@ -27,7 +51,34 @@ namespace Light
         std::byte* RemoveElement(int index);
         void RemoveElements(int index, int count);
 
-        void ForeachElements(int index, int count, const std::function<void(int itemIndex, std::byte* item)>& iterator) const;
+        template <typename TIterator> requires requires(TIterator iterator, std::byte* ptr) { iterator(0, ptr); }
+        void ForeachElements(const int index, int count, TIterator iterator) const
+        {
+            int heapIndex;
+            int heapElementIndex;
+            GetHeapIndex(index, &heapIndex, &heapElementIndex);
+
+            int foreachIndex = 0;
+            while (true)
+            {
+                //获取遍历地址和最大遍历次数
+                std::byte* headAddress = heaps[heapIndex].get() + heapElementIndex * elementSize;
+                int sequentialElementCount = chunkElementCount - heapElementIndex;
+                int foreachCount = std::min(count, sequentialElementCount);
+                //遍历元素
+                for (int i = 0; i < foreachCount; i++)
+                {
+                    iterator(foreachIndex, headAddress + i * elementSize);
+                    foreachIndex++;
+                }
+                //完成一次遍历
+                count -= sequentialElementCount;
+                if (count <= 0)
+                    break;
+                //获取下次遍历的信息
+                GetHeapIndex(index + foreachIndex, &heapIndex, &heapElementIndex);
+            }
+        }
         template <typename TIterator> requires requires(TIterator iterator, std::byte* ptr) { iterator(ptr); }
         void ForeachElements(TIterator iterator)
         {
@@ -46,20 +97,54 @@ namespace Light
                 count -= chunkElementCount;
             }
         }
+        /**
+         * 按块遍历元素所在的连续内存，适合整块复制或比较数据
+         * @param iterator 参数为块的起始地址和块中的元素数量
+         */
+        template <typename TIterator> requires requires(TIterator iterator, std::byte* ptr) { iterator(ptr, 0); }
+        void ForeachChunks(TIterator iterator) const
+        {
+            int count = elementCount;
+            int heapIndex = 0;
+            while (count > 0)
+            {
+                iterator(heaps[heapIndex].get(), std::min(count, chunkElementCount));
+                heapIndex++;
+                count -= chunkElementCount;
+            }
+        }
         std::byte* At(int index) const;
         std::byte* operator[](const int index) const { return At(index); }
 
         void CopyTo(std::byte* destination, int index, int count) const;
 
     private:
+        /**
+         * 释放块时同时记录到内存统计中
+         */
+        struct ChunkDeleter
+        {
+            size_t size;
+
+            void operator()(const std::byte* chunk) const
+            {
+                MemoryTracker::RecordDeallocation(MemoryTag::ECS, size);
+                delete[] chunk;
+            }
+        };
+
         size_t elementSize;
         int chunkElementCount;
         int spareChunkCount;
 
-        std::vector<std::unique_ptr<std::byte[]>> heaps;
+        std::vector<std::unique_ptr<std::byte[], ChunkDeleter>> heaps;
         int elementCount;
 
         void ResizeHeaps();
-        void GetHeapIndex(int elementIndex, int* heapIndex, int* heapElementIndex) const;
+        void GetHeapIndex(const int elementIndex, int* heapIndex, int* heapElementIndex) const
+        {
+            *heapIndex = elementIndex / chunkElementCount;
+            *heapElementIndex = elementIndex % chunkElementCount;
+        }
     };
 }
@@ -0,0 +1,252 @@
+﻿#include "RewindBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace Light
+{
+    //差异数据以8字节为单位编码：1字节掩码标记与关键帧异或后的非零字节，其后依次存放这些非零字节
+    //组件数据在相邻步骤间通常只有少量字节变化（如浮点数的低位），因此大部分字节可以省略
+
+    static std::byte* EncodeWord(const uint64_t difference, std::byte* output)
+    {
+        std::byte* mask = output++;
+        uint8_t maskValue = 0;
+        if (difference != 0)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                //总是写入但只在非零时前移，以避免分支
+                const uint8_t value = static_cast<uint8_t>(difference >> (i * 8));
+                *output = static_cast<std::byte>(value);
+                output += value != 0;
+                maskValue |= static_cast<uint8_t>(value != 0) << i;
+            }
+        }
+        *mask = static_cast<std::byte>(maskValue);
+        return output;
+    }
+    static uint64_t DecodeWord(const std::byte*& input)
+    {
+        const uint8_t mask = static_cast<uint8_t>(*input++);
+        uint64_t difference = 0;
+        if (mask != 0)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                if (mask >> i & 1)
+                    difference |= static_cast<uint64_t>(*input++) << (i * 8);
+            }
+        }
+        return difference;
+    }
+
+    static std::byte* EncodeDelta(const std::byte* current, const std::byte* keyframe, const size_t size, std::byte* output)
+    {
+        size_t offset = 0;
+        for (; offset + 8 <= size; offset += 8)
+        {
+            uint64_t a, b;
+            memcpy(&a, current + offset, 8);
+            memcpy(&b, keyframe + offset, 8);
+            output = EncodeWord(a ^ b, output);
+        }
+        if (offset < size)
+        {
+            uint64_t a = 0, b = 0;
+            memcpy(&a, current + offset, size - offset);
+            memcpy(&b, keyframe + offset, size - offset);
+            output = EncodeWord(a ^ b, output);
+        }
+        return output;
+    }
+    static const std::byte* DecodeDelta(const std::byte* input, const std::byte* keyframe, const size_t size, std::byte* current)
+    {
+        size_t offset = 0;
+        for (; offset + 8 <= size; offset += 8)
+        {
+            uint64_t value;
+            memcpy(&value, keyframe + offset, 8);
+            value ^= DecodeWord(input);
+            memcpy(current + offset, &value, 8);
+        }
+        if (offset < size)
+        {
+            uint64_t value = 0;
+            memcpy(&value, keyframe + offset, size - offset);
+            value ^= DecodeWord(input);
+            memcpy(current + offset, &value, size - offset);
+        }
+        return input;
+    }
+
+    RewindBuffer::RewindBuffer(const size_t memoryBudget, const int keyframeInterval)
+        : memoryBudget(memoryBudget), keyframeInterval(keyframeInterval)
+    {
+        assert(keyframeInterval > 0 && "关键帧间隔必须大于零！");
+    }
+
+    void RewindBuffer::Record(const int step)
+    {
+        Truncate(step);
+
+        std::vector<HeapLayout> layout = GetLayout();
+        const uint32_t structureVersion = World::GetStructureVersion();
+        const bool needKeyframe = groups.empty()
+            || groups.back().structureVersion != structureVersion
+            || groups.back().layout != layout
+            || static_cast<int>(groups.back().deltas.size()) + 1 >= keyframeInterval;
+
+        if (needKeyframe)
+        {
+            FrameGroup& group = groups.emplace_back();
+            group.structureVersion = structureVersion;
+            group.layout = std::move(layout);
+            group.step = step;
+
+            size_t size = 0;
+            ForeachChunks(group.layout, [&size](std::byte*, const size_t chunkSize) { size += chunkSize; });
+            group.keyframe.resize(size);
+            std::byte* output = group.keyframe.data();
+            ForeachChunks(group.layout, [&output](const std::byte* chunk, const size_t chunkSize)
+            {
+                memcpy(output, chunk, chunkSize);
+                output += chunkSize;
+            });
+
+            group.memoryUsage = size;
+            memoryUsage += size;
+        }
+        else
+        {
+            FrameGroup& group = groups.back();
+
+            //先编码到临时缓冲区中，再复制出实际大小的部分，每8字节最多需要9字节
+            const size_t maxSize = group.keyframe.size() + group.keyframe.size() / 8 + 16;
+            if (encodeBuffer.size() < maxSize)
+                encodeBuffer.resize(maxSize);
+            std::byte* output = encodeBuffer.data();
+            const std::byte* keyframe = group.keyframe.data();
+            ForeachChunks(group.layout, [&output,&keyframe](const std::byte* chunk, const size_t chunkSize)
+            {
+                output = EncodeDelta(chunk, keyframe, chunkSize, output);
+                keyframe += chunkSize;
+            });
+
+            DeltaFrame& frame = group.deltas.emplace_back();
+            frame.step = step;
+            frame.data.assign(encodeBuffer.data(), output);
+
+            group.memoryUsage += frame.data.size();
+            memoryUsage += frame.data.size();
+        }
+
+        ApplyBudget();
+    }
+    bool RewindBuffer::Seek(const int step)
+    {
+        //查找包含该步骤的关键帧组
+        auto group = groups.rbegin();
+        while (group != groups.rend() && group->step > step)
+            ++group;
+        if (group == groups.rend())
+            return false;
+
+        const DeltaFrame* frame = nullptr;
+        if (group->step != step)
+        {
+            auto iterator = std::ranges::find(group->deltas, step, &DeltaFrame::step);
+            if (iterator == group->deltas.end())
+                return false;
+            frame = &*iterator;
+        }
+
+        //实体结构已改变时记录的数据无法对应到当前的块
+        if (group->structureVersion != World::GetStructureVersion() || group->layout != GetLayout())
+            return false;
+
+        const std::byte* keyframe = group->keyframe.data();
+        if (frame == nullptr)
+        {
+            ForeachChunks(group->layout, [&keyframe](std::byte* chunk, const size_t chunkSize)
+            {
+                memcpy(chunk, keyframe, chunkSize);
+                keyframe += chunkSize;
+            });
+        }
+        else
+        {
+            const std::byte* input = frame->data.data();
+            ForeachChunks(group->layout, [&input,&keyframe](std::byte* chunk, const size_t chunkSize)
+            {
+                input = DecodeDelta(input, keyframe, chunkSize, chunk);
+                keyframe += chunkSize;
+            });
+        }
+        return true;
+    }
+    void RewindBuffer::Clear()
+    {
+        groups.clear();
+        memoryUsage = 0;
+    }
+
+    bool RewindBuffer::IsEmpty() const
+    {
+        return groups.empty();
+    }
+    int RewindBuffer::GetFirstStep() const
+    {
+        assert(!groups.empty() && "没有记录任何步骤！");
+        return groups.front().step;
+    }
+    int RewindBuffer::GetLastStep() const
+    {
+        assert(!groups.empty() && "没有记录任何步骤！");
+        const FrameGroup& group = groups.back();
+        return group.deltas.empty() ? group.step : group.deltas.back().step;
+    }
+    size_t RewindBuffer::GetMemoryUsage() const
+    {
+        return memoryUsage;
+    }
+
+    std::vector<RewindBuffer::HeapLayout> RewindBuffer::GetLayout()
+    {
+        std::vector<HeapLayout> layout;
+        World::ForeachHeaps([&layout](const Archetype& archetype, const Heap& heap)
+        {
+            if (heap.GetCount() != 0)
+                layout.push_back({&archetype, heap.GetCount()});
+        });
+        return layout;
+    }
+    void RewindBuffer::Truncate(const int step)
+    {
+        //回退后重新记录时，丢弃原先的后续步骤
+        while (!groups.empty() && groups.back().step >= step)
+        {
+            memoryUsage -= groups.back().memoryUsage;
+            groups.pop_back();
+        }
+        if (groups.empty())
+            return;
+
+        FrameGroup& group = groups.back();
+        while (!group.deltas.empty() && group.deltas.back().step >= step)
+        {
+            group.memoryUsage -= group.deltas.back().data.size();
+            memoryUsage -= group.deltas.back().data.size();
+            group.deltas.pop_back();
+        }
+    }
+    void RewindBuffer::ApplyBudget()
+    {
+        while (memoryUsage > memoryBudget && groups.size() > 1)
+        {
+            memoryUsage -= groups.front().memoryUsage;
+            groups.pop_front();
+        }
+    }
+}
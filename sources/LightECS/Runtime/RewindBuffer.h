@@ -0,0 +1,97 @@
+﻿#pragma once
+#include <deque>
+#include <vector>
+
+#include "World.h"
+
+namespace Light
+{
+    /**
+     * 记录世界中所有实体组件数据的历史，以便回退到之前的任意步骤
+     *
+     * 每隔若干步记录一次关键帧，即所有实体堆的原始内存。其余步骤只记录与关键帧的异或差异，并省略其中的零字节。
+     * 记录和回退都直接操作实体堆的内存块，不经过逐字段的序列化，因此仅适用于可平凡复制的组件。
+     * 回退时世界的实体结构需与记录时一致，实体结构变化后的首次记录会自动开始新的关键帧。
+     */
+    class RewindBuffer
+    {
+    public:
+        /**
+         * @param memoryBudget 记录数据可占用的最大字节数，超出时从最早的关键帧开始丢弃，但至少保留最新的关键帧
+         * @param keyframeInterval 关键帧的间隔步数
+         */
+        RewindBuffer(size_t memoryBudget, int keyframeInterval = 32);
+
+        /**
+         * 记录世界的当前状态
+         * @param step 步骤序号，若不大于已记录的步骤，则会先丢弃这些步骤
+         */
+        void Record(int step);
+        /**
+         * 将世界恢复到已记录的步骤
+         * @param step
+         * @return 该步骤未被记录、已被丢弃或记录后实体结构已改变时返回false
+         */
+        bool Seek(int step);
+        void Clear();
+
+        bool IsEmpty() const;
+        int GetFirstStep() const;
+        int GetLastStep() const;
+        size_t GetMemoryUsage() const;
+
+    private:
+        struct HeapLayout
+        {
+            const Archetype* archetype;
+            int count;
+
+            friend bool operator==(const HeapLayout&, const HeapLayout&) = default;
+        };
+        struct DeltaFrame
+        {
+            int step;
+            std::vector<std::byte> data;
+        };
+        /**
+         * 一个关键帧及依赖于它的差异帧
+         */
+        struct FrameGroup
+        {
+            uint32_t structureVersion;
+            std::vector<HeapLayout> layout;
+            int step;
+            std::vector<std::byte> keyframe;
+            std::vector<DeltaFrame> deltas;
+            size_t memoryUsage;
+        };
+
+        size_t memoryBudget;
+        int keyframeInterval;
+        std::deque<FrameGroup> groups;
+        size_t memoryUsage = 0;
+        std::vector<std::byte> encodeBuffer;
+
+        static std::vector<HeapLayout> GetLayout();
+        /**
+         * 按布局依次遍历各实体堆的内存块
+         * @param layout
+         * @param iterator 参数为块的起始地址和字节数
+         */
+        template <typename TIterator>
+        static void ForeachChunks(const std::vector<HeapLayout>& layout, TIterator iterator)
+        {
+            for (const HeapLayout& heapLayout : layout)
+            {
+                const Heap& heap = *World::GetEntityHeap(*heapLayout.archetype);
+                const size_t elementSize = heap.GetElementSize();
+                heap.ForeachChunks([&iterator, elementSize](std::byte* chunk, const int count)
+                {
+                    iterator(chunk, count * elementSize);
+                });
+            }
+        }
+        void Truncate(int step);
+        void ApplyBudget();
+    };
+}
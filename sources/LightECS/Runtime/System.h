@@ -1,9 +1,10 @@
 ﻿#pragma once
 #include <cassert>
-#include <functional>
 #include <ranges>
 #include <set>
 
+#include "LightUtility/Runtime/InplaceFunction.hpp"
+
 namespace Light
 {
     class SystemGroup;
@@ -87,9 +88,9 @@ namespace Light
     class SystemEvent : public System
     {
     public:
-        std::function<void()> onStart = nullptr;
-        std::function<void()> onStop = nullptr;
-        std::function<void()> onUpdate = nullptr;
+        InplaceFunction<void()> onStart = nullptr;
+        InplaceFunction<void()> onStop = nullptr;
+        InplaceFunction<void()> onUpdate = nullptr;
 
         SystemEvent(SystemGroup* group, const int order)
             : System(group, order)
@@ -2,6 +2,8 @@
 
 #include <ranges>
 
+#include "LightUtility/Runtime/Profiler.h"
+
 namespace Light
 {
     EntityInfo World::GetEntityInfo(const Entity entity)
@@ -13,7 +15,12 @@ namespace Light
     {
         return entityInfos.contains(entity);
     }
-    Entity World::AddEntity(const Archetype& archetype)
+    Entity World::AddEntity(const Archetype& archetype, const std::source_location location)
+    {
+        MemoryCallSiteScope scope(location);
+        return CreateEntity(archetype);
+    }
+    Entity World::CreateEntity(const Archetype& archetype)
     {
         Heap& heap = GetEntities(archetype);
         int startIndex = heap.GetCount();
@@ -24,11 +31,13 @@ namespace Light
             *reinterpret_cast<Entity*>(item) = entity;
             entityInfos.insert({entity, {&archetype, item, startIndex}});
         });
+        structureVersion++;
 
         return entity;
     }
-    void World::AddEntities(const Archetype& archetype, const int count, Entity* outEntities)
+    void World::AddEntities(const Archetype& archetype, const int count, Entity* outEntities, const std::source_location location)
     {
+        MemoryCallSiteScope scope(location);
         Heap& heap = GetEntities(archetype);
         int startIndex = heap.GetCount();
         heap.AddElements(count, [&archetype,outEntities,startIndex](const int itemIndex, std::byte* item)
@@ -39,9 +48,11 @@ namespace Light
             entityInfos.insert({entity, {&archetype, item, startIndex + itemIndex}});
             if (outEntities != nullptr)outEntities[itemIndex] = entity;
         });
+        structureVersion++;
     }
-    void World::MoveEntity(const Entity entity, const Archetype& newArchetype)
+    void World::MoveEntity(const Entity entity, const Archetype& newArchetype, const std::source_location location)
     {
+        MemoryCallSiteScope scope(location);
         assert(entity != Entity::Null && "目标实体为空！");
         assert(entityInfos.contains(entity) && "目标实体不存在！");
 
@@ -76,6 +87,7 @@ namespace Light
         entityInfo.indexAtHeap = newHeap.GetCount() - 1;
         //写回新实体信息
         entityInfos[entity] = entityInfo;
+        structureVersion++;
     }
     void World::RemoveEntity(Entity& entity)
     {
@@ -89,9 +101,31 @@ namespace Light
         archetype.RunDestructor(entityInfo.components);
         //从内存中移除
         RemoveHeapItem(archetype, entityInfo.indexAtHeap);
+        structureVersion++;
 
         entity = Entity::Null;
     }
+    void World::ReorderEntities(const Archetype& archetype, const std::vector<int>& order)
+    {
+        Heap& heap = entities.at(&archetype);
+        const int count = heap.GetCount();
+        assert(static_cast<int>(order.size()) == count && "重排顺序与实体数量不一致！");
+        if (count == 0)
+            return;
+
+        //先将原数据整体复制出来，再按新顺序写回
+        const size_t size = archetype.size;
+        std::vector<std::byte> buffer(size * count);
+        heap.CopyTo(buffer.data(), 0, count);
+        heap.ForeachElements(0, count, [&order,&buffer,size](const int itemIndex, std::byte* item)
+        {
+            memcpy(item, buffer.data() + order[itemIndex] * size, size);
+            //实体被移动了位置，相关实体信息也需要更变
+            EntityInfo& entityInfo = entityInfos[*reinterpret_cast<Entity*>(item)];
+            entityInfo.components = item;
+            entityInfo.indexAtHeap = itemIndex;
+        });
+    }
     bool World::HasSystem(System& system)
     {
         return systems.contains(&system);
@@ -173,6 +207,7 @@ namespace Light
     }
     void World::Update()
     {
+        LIGHT_PROFILE_ZONE("World::Update");
         systemGroup.Update();
     }
 
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <set>
 #include <cassert>
+#include <source_location>
 
 #include "Heap.h"
 #include "System.h"
@@ -27,19 +28,50 @@ namespace Light
             return &iterator->second;
         }
         static EntityInfo GetEntityInfo(Entity entity);
+        /**
+         * 遍历所有原形的实体堆
+         * @param iterator 参数为原形和其实体堆
+         */
+        template <typename TIterator> requires requires(TIterator iterator, const Archetype& archetype, Heap& heap) { iterator(archetype, heap); }
+        static void ForeachHeaps(TIterator iterator)
+        {
+            for (auto& [archetype, heap] : entities)
+                iterator(*archetype, heap);
+        }
 
         static bool HasEntity(Entity entity);
-        static Entity AddEntity(const Archetype& archetype);
+        /**
+         * @param archetype
+         * @param location 实体堆扩容时，该分配归属的调用点
+         * @return
+         */
+        static Entity AddEntity(const Archetype& archetype, std::source_location location = std::source_location::current());
+        /**
+         * @note 可变参数后无法获取调用点，实体堆扩容的分配归属到外层的MemoryCallSiteScope
+         */
         template <Component... TComponents>
         static Entity AddEntity(const Archetype& archetype, const TComponents&... components)
         {
-            Entity entity = AddEntity(archetype);
+            Entity entity = CreateEntity(archetype);
             SetComponents(entity, components...);
             return entity;
         }
-        static void AddEntities(const Archetype& archetype, int count, Entity* outEntities = nullptr);
-        static void MoveEntity(Entity entity, const Archetype& newArchetype);
+        static void AddEntities(const Archetype& archetype, int count, Entity* outEntities = nullptr,
+                                std::source_location location = std::source_location::current());
+        static void MoveEntity(Entity entity, const Archetype& newArchetype, std::source_location location = std::source_location::current());
         static void RemoveEntity(Entity& entity);
+        /**
+         * 按给定顺序重排原形实体堆中的实体，以改善遍历时的内存局部性
+         * @param archetype 
+         * @param order 重排后第i个位置的实体在重排前的位置
+         * @note 重排不会改变结构版本
+         */
+        static void ReorderEntities(const Archetype& archetype, const std::vector<int>& order);
+        /**
+         * 结构版本会在实体增删或更换原形时递增，可用于判断基于实体结构生成的缓存数据是否过期
+         * @return 
+         */
+        static uint32_t GetStructureVersion() { return structureVersion; }
 
         static bool HasSystem(System& system);
         static void AddSystem(System& system);
@@ -103,11 +135,13 @@ namespace Light
     private:
         friend struct HierarchyWindow;
         inline static uint32_t nextEntity = 1;
+        inline static uint32_t structureVersion = 0;
         inline static std::unordered_map<const Archetype*, Heap> entities = {};
         inline static std::unordered_map<Entity, EntityInfo> entityInfos = {};
         inline static std::unordered_map<System*, int> systems = {};
         inline static SystemGroup systemGroup = {nullptr, 0};
 
+        static Entity CreateEntity(const Archetype& archetype);
         static void RemoveHeapItem(const Archetype& archetype, int index);
     };
 }
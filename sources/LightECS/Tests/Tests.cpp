@@ -6,6 +6,7 @@
 #include "LightECS/Runtime/Archetype.hpp"
 #include "LightECS/Runtime/World.h"
 #include "LightECS/Runtime/Heap.h"
+#include "LightECS/Runtime/RewindBuffer.h"
 #include "LightECS/Runtime/View.hpp"
 
 using namespace Light;
@@ -193,6 +194,111 @@ TEST(ECS, World)
     ASSERT_EQ(World::GetComponent<Transform>(entities[0]), Transform{3});
 }
 
+TEST(ECS, ReorderEntities)
+{
+    //超过一个块的容量，以覆盖跨块遍历的情况
+    constexpr int count = 150;
+    Entity entities[count];
+    World::AddEntities(physicsArchetype, count, entities);
+    for (int i = 0; i < count; i++)
+        World::SetComponents(entities[i], Transform{static_cast<float>(i)});
+
+    const int startIndex = World::GetEntityInfo(entities[0]).indexAtHeap;
+    const uint32_t structureVersion = World::GetStructureVersion();
+    std::vector<int> order(World::GetEntities(physicsArchetype).GetCount());
+    for (int i = 0; i < static_cast<int>(order.size()); i++)
+        order[i] = i < startIndex ? i : startIndex + (count - 1 - (i - startIndex));
+    World::ReorderEntities(physicsArchetype, order);
+    ASSERT_EQ(World::GetStructureVersion(), structureVersion);
+
+    for (int i = 0; i < count; i++)
+    {
+        EntityInfo entityInfo = World::GetEntityInfo(entities[i]);
+        ASSERT_EQ(entityInfo.indexAtHeap, startIndex + count - 1 - i);
+        ASSERT_EQ(entityInfo.components, World::GetEntities(physicsArchetype).At(entityInfo.indexAtHeap));
+        ASSERT_EQ(World::GetComponent<Transform>(entities[i]), Transform{static_cast<float>(i)});
+    }
+
+    for (Entity& entity : entities)
+        World::RemoveEntity(entity);
+}
+
+TEST(ECS, RewindBuffer)
+{
+    constexpr int count = 150;
+    constexpr int stepCount = 40;
+    Entity entities[count];
+    World::AddEntities(physicsArchetype, count, entities);
+    for (int i = 0; i < count; i++)
+        World::SetComponents(entities[i], Transform{static_cast<float>(i)}, RigidBody{0, 1, static_cast<float>(i % 7)});
+
+    //逐步模拟并记录，同时保存每一步的位置用于校验
+    auto simulate = []
+    {
+        View<Transform, RigidBody>::Each([](Transform& transform, RigidBody& rigidBody)
+        {
+            rigidBody.velocity += -9.8f * 0.02f;
+            transform.position += rigidBody.velocity * 0.02f;
+        });
+    };
+    std::vector<std::vector<float>> history(stepCount);
+    RewindBuffer rewindBuffer = {std::numeric_limits<size_t>::max(), 8};
+    for (int step = 0; step < stepCount; step++)
+    {
+        rewindBuffer.Record(step);
+        for (Entity entity : entities)
+            history[step].push_back(World::GetComponent<Transform>(entity).position);
+        simulate();
+    }
+    ASSERT_EQ(rewindBuffer.GetFirstStep(), 0);
+    ASSERT_EQ(rewindBuffer.GetLastStep(), stepCount - 1);
+
+    //差异帧应远小于关键帧
+    RewindBuffer keyframeBuffer = {std::numeric_limits<size_t>::max()};
+    keyframeBuffer.Record(0);
+    ASSERT_LT(rewindBuffer.GetMemoryUsage(), keyframeBuffer.GetMemoryUsage() * stepCount / 2);
+
+    //回退到任意步骤，包括关键帧和差异帧
+    for (int step : {37, 0, 8, 13, 31, 39})
+    {
+        ASSERT_TRUE(rewindBuffer.Seek(step));
+        for (int i = 0; i < count; i++)
+            ASSERT_EQ(World::GetComponent<Transform>(entities[i]).position, history[step][i]);
+    }
+    ASSERT_FALSE(rewindBuffer.Seek(stepCount));
+
+    //回退后重新记录会丢弃原先的后续步骤
+    ASSERT_TRUE(rewindBuffer.Seek(10));
+    World::SetComponents(entities[0], Transform{-1});
+    rewindBuffer.Record(11);
+    ASSERT_EQ(rewindBuffer.GetLastStep(), 11);
+    ASSERT_FALSE(rewindBuffer.Seek(12));
+    ASSERT_TRUE(rewindBuffer.Seek(10));
+    ASSERT_EQ(World::GetComponent<Transform>(entities[0]).position, history[10][0]);
+    ASSERT_TRUE(rewindBuffer.Seek(11));
+    ASSERT_EQ(World::GetComponent<Transform>(entities[0]).position, -1);
+
+    //超出内存预算时丢弃最早的关键帧组
+    RewindBuffer budgetBuffer = {keyframeBuffer.GetMemoryUsage() * 4, 4};
+    for (int step = 0; step < stepCount; step++)
+    {
+        budgetBuffer.Record(step);
+        simulate();
+    }
+    ASSERT_LE(budgetBuffer.GetMemoryUsage(), keyframeBuffer.GetMemoryUsage() * 4);
+    ASSERT_GT(budgetBuffer.GetFirstStep(), 0);
+    ASSERT_FALSE(budgetBuffer.Seek(0));
+    ASSERT_TRUE(budgetBuffer.Seek(stepCount - 1));
+
+    //实体结构改变后无法回退
+    Entity extraEntity = World::AddEntity(physicsArchetype);
+    ASSERT_FALSE(budgetBuffer.Seek(stepCount - 1));
+    World::RemoveEntity(extraEntity);
+
+    for (Entity& entity : entities)
+        World::RemoveEntity(entity);
+}
+
 /**
  * 质点弹簧物理系统模拟：https://zhuanlan.zhihu.com/p/361126215
  */
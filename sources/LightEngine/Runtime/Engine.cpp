@@ -1,23 +1,29 @@
 ﻿#include "Engine.h"
 #include <LightWindow/Runtime/Window.h>
+#include <LightUtility/Runtime/FrameArena.h>
+#include <LightUtility/Runtime/Logger.h>
+#include <LightUtility/Runtime/MemoryTracker.h>
+#include <LightUtility/Runtime/Profiler.h>
+#include <LightUtility/Runtime/Task.h>
 
 using namespace Light;
 
-void Engine::AddBeginEvent(const std::function<void()>& beginEvent)
+void Engine::AddBeginEvent(InplaceFunction<void()> beginEvent)
 {
-    engineBeginEvents.push_back(beginEvent);
+    engineBeginEvents.push_back(std::move(beginEvent));
 }
-void Engine::AddEndEvent(const std::function<void()>& endEvent)
+void Engine::AddEndEvent(InplaceFunction<void()> endEvent)
 {
-    engineEndEvents.push_back(endEvent);
+    engineEndEvents.push_back(std::move(endEvent));
 }
-void Engine::AddUpdateEvent(const std::function<void()>& updateEvent)
+void Engine::AddUpdateEvent(InplaceFunction<void()> updateEvent)
 {
-    engineUpdateEvents.push_back(updateEvent);
+    engineUpdateEvents.push_back(std::move(updateEvent));
 }
 
 void Engine::Initialize()
 {
+    Logger::InstallCrashHandler();
     Window::Initialize();
 }
 
@@ -41,6 +47,10 @@ void Engine::Begin()
     {
         for (const auto& event : engineUpdateEvents)
             event();
+        Coroutine::RunMainThread();
+        FrameArena::EndFrame();
+        MemoryTracker::EndFrame();
+        LIGHT_PROFILE_FRAME();
     });
 
     Window::Start();
@@ -6,7 +6,7 @@
 
 #include "../GL.h"
 
-void GLCommandBuffer::ExecuteSingleTimeCommands(const std::function<void(const GLCommandBuffer&)>& setCommands)
+void GLCommandBuffer::ExecuteSingleTimeCommands(const Light::InplaceFunction<void(const GLCommandBuffer&)>& setCommands)
 {
     GLCommandBuffer glCommandBuffer = {};
     glCommandBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
@@ -373,8 +373,8 @@ void GLCommandBuffer::ExecuteSubCommands(const GLCommandBuffer& subCommandBuffer
     vkCmdExecuteCommands(commandBuffer, 1, &subCommandBuffer.commandBuffer);
 }
 
-void GLCommandBuffer::SubmitCommandsAsync(const std::vector<VkPipelineStageFlags>& waitStages, const std::vector<VkSemaphore>& waitSemaphores,
-                                          const std::vector<VkSemaphore>& signalSemaphores)
+void GLCommandBuffer::SubmitCommandsAsync(const std::span<const VkPipelineStageFlags> waitStages, const std::span<const VkSemaphore> waitSemaphores,
+                                          const std::span<const VkSemaphore> signalSemaphores)
 {
     //提交命令
     VkSubmitInfo submitInfo{};
@@ -394,7 +394,7 @@ void GLCommandBuffer::SubmitCommandsAsync(const std::vector<VkPipelineStageFlags
 
     isSubmitting = true;
 }
-void GLCommandBuffer::SubmitCommands(const std::vector<VkPipelineStageFlags>& waitStages, const std::vector<VkSemaphore>& waitSemaphores)
+void GLCommandBuffer::SubmitCommands(const std::span<const VkPipelineStageFlags> waitStages, const std::span<const VkSemaphore> waitSemaphores)
 {
     SubmitCommandsAsync(waitStages, waitSemaphores, {});
     WaitSubmissionFinish();
@@ -408,3 +408,14 @@ void GLCommandBuffer::WaitSubmissionFinish()
     vkResetFences(GL::glDevice->device, 1, &submissionFence);
     isSubmitting = false;
 }
+bool GLCommandBuffer::IsSubmissionFinished()
+{
+    if (isSubmitting == false)
+        return true;
+
+    if (vkGetFenceStatus(GL::glDevice->device, submissionFence) != VK_SUCCESS)
+        return false;
+    vkResetFences(GL::glDevice->device, 1, &submissionFence);
+    isSubmitting = false;
+    return true;
+}
@@ -1,9 +1,10 @@
 ﻿#pragma once
-#include <functional>
+#include <span>
 #include "GLFramebuffer.h"
 #include "GLPipeline.h"
 #include "../Resource/GLBuffer.h"
 #include  "../Resource/GLDescriptorSet.h"
+#include "LightUtility/Runtime/InplaceFunction.hpp"
 
 /**
  * 带有KHR和EXT后缀的是扩展命令，目前不是vulkan的核心命令，需要一定前置要求来开启。
@@ -12,7 +13,7 @@
 class GLCommandBuffer
 {
 public:
-    static void ExecuteSingleTimeCommands(const std::function<void(const GLCommandBuffer&)>& setCommands);
+    static void ExecuteSingleTimeCommands(const Light::InplaceFunction<void(const GLCommandBuffer&)>& setCommands);
 
     VkCommandBuffer commandBuffer;
 
@@ -116,15 +117,20 @@ public:
      * @param signalSemaphores
      * @note 由于是异步执行，需要调用@c WaitSubmissionFinish() 来等待完成。
      */
-    void SubmitCommandsAsync(const std::vector<VkPipelineStageFlags>& waitStages, const std::vector<VkSemaphore>& waitSemaphores,
-                             const std::vector<VkSemaphore>& signalSemaphores);
+    void SubmitCommandsAsync(std::span<const VkPipelineStageFlags> waitStages, std::span<const VkSemaphore> waitSemaphores,
+                             std::span<const VkSemaphore> signalSemaphores);
     /**
      * @brief 将命令缓冲区中记录的命令呈送到图形管道并等待执行完毕。
      * @param waitStages 
      * @param waitSemaphores 
      */
-    void SubmitCommands(const std::vector<VkPipelineStageFlags>& waitStages = {}, const std::vector<VkSemaphore>& waitSemaphores = {});
+    void SubmitCommands(std::span<const VkPipelineStageFlags> waitStages = {}, std::span<const VkSemaphore> waitSemaphores = {});
     void WaitSubmissionFinish();
+    /**
+     * @brief 查询异步提交的命令是否已执行完毕，不会阻塞。
+     * @return 没有正在执行的提交时也返回true，执行完毕时会同时重置提交状态。
+     */
+    bool IsSubmissionFinished();
 
 private:
     VkCommandBufferLevel level;
@@ -4,6 +4,7 @@
 
 #include "../GL.h"
 #include "../Pipeline/GLCommandBuffer.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
 
 GLBuffer* GLBuffer::CreateTransmitter(const void* data, const size_t size)
 {
@@ -48,6 +49,8 @@ GLBuffer::GLBuffer(const size_t size, const VkBufferUsageFlags usage, const VkMe
     allocInfo.memoryTypeIndex = GL::glDevice->FindMemoryType(memRequirements.memoryTypeBits, properties);
     if (VkResult result = vkAllocateMemory(GL::glDevice->device, &allocInfo, nullptr, &bufferMemory); result != VK_SUCCESS)
         throw std::runtime_error("分配缓冲区内存失败!");
+    memorySize = memRequirements.size;
+    Light::MemoryTracker::RecordAllocation(Light::MemoryTag::GPUBuffer, memorySize);
 
     //绑定内存与缓冲区
     vkBindBufferMemory(GL::glDevice->device, buffer, bufferMemory, 0);
@@ -61,6 +64,7 @@ GLBuffer::~GLBuffer()
 {
     vkDestroyBuffer(GL::glDevice->device, buffer, nullptr);
     vkFreeMemory(GL::glDevice->device, bufferMemory, nullptr);
+    Light::MemoryTracker::RecordDeallocation(Light::MemoryTag::GPUBuffer, memorySize);
 }
 
 void* GLBuffer::MapMemory() const
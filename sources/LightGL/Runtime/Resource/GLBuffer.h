@@ -19,6 +19,7 @@ public:
 
     VkBuffer buffer;
     VkDeviceMemory bufferMemory;
+    VkDeviceSize memorySize;
     size_t size;
 
     GLBuffer(size_t size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
@@ -6,6 +6,7 @@
 #include "GLBuffer.h"
 #include "../Pipeline/GLCommandBuffer.h"
 #include "../GL.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
 
 void CmdTransitionImageLayout(
     const GLCommandBuffer& glCommandBuffer, const VkImage& image,
@@ -212,6 +213,8 @@ GLImage::GLImage(const uint32_t width, const uint32_t height, const VkFormat for
 
     if (VkResult result = vkAllocateMemory(GL::glDevice->device, &allocInfo, nullptr, &memory); result != VK_SUCCESS)
         throw std::runtime_error("分配图片内存失败！");
+    memorySize = memRequirements.size;
+    Light::MemoryTracker::RecordAllocation(Light::MemoryTag::GPUImage, memorySize);
 
     vkBindImageMemory(GL::glDevice->device, image, memory, 0);
 }
@@ -219,4 +222,5 @@ GLImage::~GLImage()
 {
     vkDestroyImage(GL::glDevice->device, image, nullptr);
     vkFreeMemory(GL::glDevice->device, memory, nullptr);
+    Light::MemoryTracker::RecordDeallocation(Light::MemoryTag::GPUImage, memorySize);
 }
@@ -21,6 +21,7 @@ public:
 
     VkImage image;
     VkDeviceMemory memory;
+    VkDeviceSize memorySize;
     VkImageLayout layout;
     VkFormat format;
     uint32_t width;
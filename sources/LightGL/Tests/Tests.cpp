@@ -244,10 +244,11 @@ public:
         glCommandBuffer.EndRecording();
 
         //提交命令
+        constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         glCommandBuffer.SubmitCommandsAsync(
-            {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT}, //在颜色输出阶段要进行等待
-            {imageAvailable}, //等待到交换链的下一张图片可用时继续
-            {renderFinishedSemaphores} //完成后发出渲染完成信号量
+            {&waitStage, 1}, //在颜色输出阶段要进行等待
+            {&imageAvailable, 1}, //等待到交换链的下一张图片可用时继续
+            {&renderFinishedSemaphores, 1} //完成后发出渲染完成信号量
         );
 
         glSwapChain->PresentImageAsync();
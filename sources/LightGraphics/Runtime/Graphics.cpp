@@ -15,7 +15,7 @@ Graphics Graphics::Initialize(GL&)
         GraphicsPreset::DefaultColorFormat,
         GraphicsPreset::DefaultDepthStencilFormat,
         GraphicsPreset::DefaultStateLayout.multisample.rasterizationSamples);
-    paintCommandBufferPool = std::make_unique<ObjectPool<CommandBuffer>>();
+    paintCommandBufferPool = std::make_unique<ObjectPool<CommandBuffer>>(ObjectPoolThreading::ThreadCache);
     defaultRenderTarget = &SwapChain::GetPresentRenderTarget();
     return {};
 }
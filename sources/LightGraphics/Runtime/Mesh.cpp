@@ -27,8 +27,9 @@ buffer[index] = vertices[index].propertyName; \
     GetProperty(UVs, float2, uv)
 
 #define SetProperty(functionName,propertyType,propertyName) \
-void Mesh::Set##functionName(const std::vector<propertyType>& data) \
+void Mesh::Set##functionName(const std::vector<propertyType>& data, const std::source_location location) \
 { \
+MemoryCallSiteScope scope(location); \
 const size_t size = data.size(); \
 if (vertices.size() != size) \
 vertices.resize(size); \
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <memory>
+#include <source_location>
 
 #include "LightGL/Runtime/Resource/GLBuffer.h"
 #include "LightImport/Runtime/ModelImporter.h"
@@ -8,6 +9,7 @@
 #include "GraphicsAssets.h"
 #include "GraphicsPreset.h"
 #include "LightGL/Runtime/Pipeline/GLCommandBuffer.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
 
 namespace Light
 {
@@ -30,7 +32,7 @@ namespace Light
          * 如果你直接修改了其内容，必须显式调用@c SetDirty 以重新上传到GPU。
          * @return 
          */
-        std::vector<TVertex>& GetVertices()
+        TrackedVector<TVertex, MemoryTag::Mesh>& GetVertices()
         {
             return vertices;
         }
@@ -40,18 +42,24 @@ namespace Light
          * 如果你直接修改了其内容，必须显式调用@c SetDirty 以重新上传到GPU。
          * @return 
          */
-        std::vector<uint32_t>& GetIndices()
+        TrackedVector<uint32_t, MemoryTag::Mesh>& GetIndices()
         {
             return indices;
         }
-        void SetVertices(const std::vector<TVertex>& data)
+        /**
+         * @param data
+         * @param location 缓冲区扩容时，该分配归属的调用点
+         */
+        void SetVertices(const std::vector<TVertex>& data, const std::source_location location = std::source_location::current())
         {
+            MemoryCallSiteScope scope(location);
             vertices.resize(data.size());
             std::ranges::copy(data, vertices.data());
             isDirty = true;
         }
-        void SetIndices(const std::vector<uint32_t>& data)
+        void SetIndices(const std::vector<uint32_t>& data, const std::source_location location = std::source_location::current())
         {
+            MemoryCallSiteScope scope(location);
             indices.resize(data.size());
             std::ranges::copy(data, indices.data());
             isDirty = true;
@@ -73,8 +81,8 @@ namespace Light
         }
 
     protected:
-        std::vector<TVertex> vertices;
-        std::vector<uint32_t> indices;
+        TrackedVector<TVertex, MemoryTag::Mesh> vertices;
+        TrackedVector<uint32_t, MemoryTag::Mesh> indices;
 
     private:
         bool isDirty;
@@ -157,9 +165,9 @@ namespace Light
         void GetTangents(std::vector<float3>& buffer) const;
         void GetUVs(std::vector<float2>& buffer) const;
 
-        void SetPositions(const std::vector<float3>& data);
-        void SetNormals(const std::vector<float3>& data);
-        void SetTangents(const std::vector<float3>& data);
-        void SetUVs(const std::vector<float2>& data);
+        void SetPositions(const std::vector<float3>& data, std::source_location location = std::source_location::current());
+        void SetNormals(const std::vector<float3>& data, std::source_location location = std::source_location::current());
+        void SetTangents(const std::vector<float3>& data, std::source_location location = std::source_location::current());
+        void SetUVs(const std::vector<float2>& data, std::source_location location = std::source_location::current());
     };
 }
@@ -4,6 +4,7 @@
 
 #include "LightGL/Runtime/GL.h"
 #include "LightGL/Runtime/Pipeline/GLSwapChain.h"
+#include "LightUtility/Runtime/Profiler.h"
 
 namespace Light
 {
@@ -13,6 +14,7 @@ namespace Light
     }
     bool SwapChain::BeginPresent(GLCommandBuffer** outPresentCommandBuffer)
     {
+        LIGHT_PROFILE_ZONE("SwapChain::BeginPresent");
         bool canPresent = true;
 
         //获取交换链下次呈现使用的相关信息
@@ -40,13 +42,15 @@ namespace Light
     }
     void SwapChain::EndPresent(GLCommandBuffer& presentCommandBuffer)
     {
+        LIGHT_PROFILE_ZONE("SwapChain::EndPresent");
         presentCommandBuffer.EndRecording();
 
         //提交命令
+        constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         presentCommandBuffer.SubmitCommandsAsync(
-            {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT}, //在颜色输出阶段要进行等待
-            {currentImageAvailable}, //等待到交换链的下一张图片可用时继续
-            {currentRenderFinishedSemaphores} //完成后发出渲染完成信号量
+            {&waitStage, 1}, //在颜色输出阶段要进行等待
+            {&currentImageAvailable, 1}, //等待到交换链的下一张图片可用时继续
+            {&currentRenderFinishedSemaphores, 1} //完成后发出渲染完成信号量
         );
 
         glSwapChain->PresentImageAsync();
@@ -5,6 +5,18 @@
 
 namespace Light
 {
+    static VkFormat GetImageFormat(const int channel)
+    {
+        switch (channel)
+        {
+        case STBI_grey: return VK_FORMAT_R8_SRGB;
+        case STBI_grey_alpha: return VK_FORMAT_R8G8_SRGB;
+        case STBI_rgb: return VK_FORMAT_R8G8B8_SRGB;
+        case STBI_rgb_alpha: return VK_FORMAT_R8G8B8A8_SRGB;
+        default: throw std::runtime_error("不支持的通道类型！");
+        }
+    }
+
     Texture2D::Texture2D(const int width, const int height, const VkFormat format,
                          const void* data, const size_t size, const bool mipChain)
     {
@@ -27,22 +39,18 @@ namespace Light
     Texture2D::Texture2D(const char* fileName)
     {
         RawImage rawImage = ImageImporter::Import(fileName, STBI_rgb_alpha);
-        VkFormat format;
-        switch (rawImage.channel)
-        {
-        case STBI_grey: format = VK_FORMAT_R8_SRGB;
-            break;
-        case STBI_grey_alpha: format = VK_FORMAT_R8G8_SRGB;
-            break;
-        case STBI_rgb: format = VK_FORMAT_R8G8B8_SRGB;
-            break;
-        case STBI_rgb_alpha: format = VK_FORMAT_R8G8B8A8_SRGB;
-            break;
-        default: throw std::runtime_error("不支持的通道类型！");
-        }
-
         new(this) Texture2D(
-            rawImage.width, rawImage.height, format,
+            rawImage.width, rawImage.height, GetImageFormat(rawImage.channel),
+            rawImage.pixels.data(), rawImage.pixels.size(), true);
+    }
+
+    Task<std::unique_ptr<Texture2D>> Texture2D::LoadAsync(const std::string fileName)
+    {
+        RawImage rawImage = co_await ImageImporter::ImportAsync(fileName, STBI_rgb_alpha);
+        //图形资源在主线程上创建
+        co_await Coroutine::SwitchToMainThread();
+        co_return std::make_unique<Texture2D>(
+            rawImage.width, rawImage.height, GetImageFormat(rawImage.channel),
             rawImage.pixels.data(), rawImage.pixels.size(), true);
     }
 }
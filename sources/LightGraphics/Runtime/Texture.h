@@ -1,11 +1,13 @@
 ﻿#pragma once
 #include <memory>
+#include <string>
 
 #include "GraphicsAssets.h"
 #include "LightGL/Runtime/Resource/GLImage.h"
 #include "LightGL/Runtime/Resource/GLImageSampler.h"
 #include "LightGL/Runtime/Resource/GLImageView.h"
 #include "LightMath/Runtime/Vector.hpp"
+#include "LightUtility/Runtime/Task.h"
 
 namespace Light
 {
@@ -16,6 +18,14 @@ namespace Light
         Texture2D(float4 color);
         Texture2D(const char* fileName);
 
+        /**
+         * 异步加载图片纹理：在I/O线程上读取文件，在工作线程上解码，最后切换到主线程创建图像。
+         * 需要主线程每帧调用Coroutine::RunMainThread
+         * @param fileName
+         * @return
+         */
+        static Task<std::unique_ptr<Texture2D>> LoadAsync(std::string fileName);
+
     private:
         std::unique_ptr<GLImage> image;
         std::unique_ptr<GLImageView> imageView;
@@ -64,6 +64,12 @@ std::unique_ptr<RenderTexture> renderTexture;
 
 void CreateAssets()
 {
+    //文件读取和解码在后台进行，与下方的着色器编译等主线程工作重叠
+    Task<RawMesh> boxMeshTask = ModelImporter::ImportObjAsync("Assets/Cube.obj");
+    boxMeshTask.Start();
+    Task<std::unique_ptr<Texture2D>> imageTextureTask = Texture2D::LoadAsync("Assets/texture.jpg");
+    imageTextureTask.Start();
+
     //全屏网格
     fullScreenMesh = std::make_unique<Mesh>();
     fullScreenMesh->SetPositions({
@@ -83,10 +89,10 @@ void CreateAssets()
         0, 2, 3
     });
     //盒状网格
-    boxMesh = std::make_unique<Mesh>(ModelImporter::ImportObj("Assets/Cube.obj"));
+    boxMesh = std::make_unique<Mesh>(boxMeshTask.Get());
     //自定义盒状网格
-    const std::vector<GraphicsPreset::Vertex>& vertices = boxMesh->GetVertices();
-    const std::vector<uint32_t>& indices = boxMesh->GetIndices();
+    const auto& vertices = boxMesh->GetVertices();
+    const auto& indices = boxMesh->GetIndices();
     std::vector<Point> wireVertices = std::vector<Point>{vertices.size()};
     for (size_t i = 0; i < vertices.size(); ++i)
     {
@@ -98,15 +104,20 @@ void CreateAssets()
     }
     customBoxMesh = std::make_unique<MeshT<Point>>();
     customBoxMesh->SetVertices(wireVertices);
-    customBoxMesh->SetIndices(indices);
+    customBoxMesh->SetIndices({indices.begin(), indices.end()});
 
     //标准着色器
     shader = std::make_unique<Shader>("Assets/Shader.hlsl");
     //自定义线着色器
     lineShader = std::make_unique<Shader>("Assets/CustomVertexShader.hlsl", GraphicsPreset::DefaultStateLayout, LineMeshLayout);
 
-    //图片纹理
-    imageTexture2D = std::make_unique<Texture2D>("Assets/texture.jpg");
+    //图片纹理，解码完成后需由主线程创建图像
+    while (!imageTextureTask.IsCompleted())
+    {
+        Coroutine::RunMainThread();
+        std::this_thread::yield();
+    }
+    imageTexture2D = imageTextureTask.Get();
     //白色纹理
     whiteTexture2D = std::make_unique<Texture2D>(1);
 
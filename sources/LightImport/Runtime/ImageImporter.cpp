@@ -4,15 +4,17 @@
 #include <stb_image.h>
 #include <stdexcept>
 
+#include "LightUtility/Runtime/FileIO.h"
+#include "LightUtility/Runtime/Profiler.h"
+
 using namespace Light;
 
-RawImage ImageImporter::Import(const std::string& filePath, const int desiredChannel)
+//从内存中的文件数据解码，像素布局为从左上开始，逐行扫描
+static RawImage Decode(const std::vector<std::byte>& fileData, const int desiredChannel)
 {
     RawImage image;
-
-    //像素布局为从左上开始，逐行扫描
-    stbi_uc* pixels = stbi_load(
-        filePath.c_str(),
+    stbi_uc* pixels = stbi_load_from_memory(
+        reinterpret_cast<const stbi_uc*>(fileData.data()), static_cast<int>(fileData.size()),
         &image.width, &image.height,
         &image.channel, desiredChannel
     );
@@ -29,3 +31,25 @@ RawImage ImageImporter::Import(const std::string& filePath, const int desiredCha
 
     return image;
 }
+
+RawImage ImageImporter::Import(const std::string& filePath, const int desiredChannel)
+{
+    LIGHT_PROFILE_ZONE("ImageImporter::Import");
+
+    FileIO& fileIO = FileIO::GetDefault();
+    std::vector<std::byte> fileData = FileIO::Read(filePath, fileIO.AcquireBuffer());
+    RawImage image = Decode(fileData, desiredChannel);
+    fileIO.RecycleBuffer(std::move(fileData));
+    return image;
+}
+Task<RawImage> ImageImporter::ImportAsync(const std::string filePath, const int desiredChannel)
+{
+    FileIO& fileIO = FileIO::GetDefault();
+    std::vector<std::byte> fileData = co_await Coroutine::ReadFile(filePath, fileIO.AcquireBuffer());
+
+    //此时已位于工作线程，I/O线程可以继续读取其他文件
+    LIGHT_PROFILE_ZONE("ImageImporter::Decode");
+    RawImage image = Decode(fileData, desiredChannel);
+    fileIO.RecycleBuffer(std::move(fileData));
+    co_return image;
+}
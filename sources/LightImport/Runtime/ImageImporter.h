@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 
+#include "LightUtility/Runtime/Task.h"
+
 namespace Light
 {
     struct RawImage
@@ -24,5 +26,13 @@ namespace Light
          * @return 
          */
         static RawImage Import(const std::string& filePath, int desiredChannel = STBI_default);
+        /**
+         * 异步加载图片：文件由FileIO的I/O线程读取到池化的缓冲区，读取完成后在工作线程上解码，
+         * 因此多张图片的读取和解码可以相互重叠，等待者也无需占用线程。
+         * @param filePath
+         * @param desiredChannel
+         * @return
+         */
+        static Task<RawImage> ImportAsync(std::string filePath, int desiredChannel = STBI_default);
     };
 }
@@ -2,9 +2,12 @@
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
+#include <sstream>
 #include <unordered_map>
 
 #include "LightMath/Runtime/VectorMath.hpp"
+#include "LightUtility/Runtime/FileIO.h"
+#include "LightUtility/Runtime/Profiler.h"
 
 using namespace Light;
 
@@ -29,18 +32,23 @@ struct std::hash<ObjVertex>
     }
 };
 
-RawMesh ModelImporter::ImportObj(const std::string& filePath)
+//从内存中的文件数据解析
+static RawMesh Parse(const std::vector<std::byte>& fileData)
 {
     RawMesh mesh = {};
 
-    static std::unordered_map<ObjVertex, uint32_t> uniqueVertices{};
+    //每个网格单独去重，且解析可能同时在多个工作线程上进行，因此不能共享
+    std::unordered_map<ObjVertex, uint32_t> uniqueVertices{};
 
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
     std::string warn, err;
 
-    if (!LoadObj(&attrib, &shapes, &materials, &warn, &err, filePath.c_str()))
+    //材质文件与直接按路径加载时一样，相对于工作目录查找
+    std::istringstream stream(std::string(reinterpret_cast<const char*>(fileData.data()), fileData.size()));
+    tinyobj::MaterialFileReader materialReader("");
+    if (!LoadObj(&attrib, &shapes, &materials, &warn, &err, &stream, &materialReader))
         throw std::runtime_error(warn + err);
 
     for (const auto& shape : shapes)
@@ -80,3 +88,24 @@ RawMesh ModelImporter::ImportObj(const std::string& filePath)
 
     return mesh;
 }
+
+RawMesh ModelImporter::ImportObj(const std::string& filePath)
+{
+    LIGHT_PROFILE_ZONE("ModelImporter::ImportObj");
+
+    FileIO& fileIO = FileIO::GetDefault();
+    std::vector<std::byte> fileData = FileIO::Read(filePath, fileIO.AcquireBuffer());
+    RawMesh mesh = Parse(fileData);
+    fileIO.RecycleBuffer(std::move(fileData));
+    return mesh;
+}
+Task<RawMesh> ModelImporter::ImportObjAsync(const std::string filePath)
+{
+    FileIO& fileIO = FileIO::GetDefault();
+    std::vector<std::byte> fileData = co_await Coroutine::ReadFile(filePath, fileIO.AcquireBuffer());
+
+    LIGHT_PROFILE_ZONE("ModelImporter::Parse");
+    RawMesh mesh = Parse(fileData);
+    fileIO.RecycleBuffer(std::move(fileData));
+    co_return mesh;
+}
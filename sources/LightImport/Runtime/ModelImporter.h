@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "LightMath/Runtime/Vector.hpp"
+#include "LightUtility/Runtime/Task.h"
 
 namespace Light
 {
@@ -25,5 +26,11 @@ namespace Light
          * @return 
          */
         static RawMesh ImportObj(const std::string& filePath);
+        /**
+         * 异步加载obj文件，文件由I/O线程读取，读取完成后在工作线程上解析，用法同ImageImporter::ImportAsync
+         * @param filePath
+         * @return
+         */
+        static Task<RawMesh> ImportObjAsync(std::string filePath);
     };
 }
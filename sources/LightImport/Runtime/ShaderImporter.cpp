@@ -2,6 +2,7 @@
 
 #include <map>
 
+#include "LightUtility/Runtime/Profiler.h"
 #include "LightUtility/Runtime/Utility.hpp"
 
 #include <stdexcept>
@@ -45,6 +46,7 @@ class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface
 
 std::vector<std::byte> ShaderImporter::ImportHlsl(const std::string& code, const shaderc_shader_kind type, const std::string& entryPoint)
 {
+    LIGHT_PROFILE_ZONE("ShaderImporter::ImportHlsl");
     shaderc::Compiler compiler;
     shaderc::CompileOptions options;
 
@@ -66,6 +68,7 @@ std::vector<std::byte> ShaderImporter::ImportHlsl(const std::string& code, const
 }
 std::vector<std::byte> ShaderImporter::ImportHlslFromFile(const std::string& file, const shaderc_shader_kind type, const std::string& entryPoint)
 {
+    LIGHT_PROFILE_ZONE("ShaderImporter::ImportHlslFromFile");
     shaderc::Compiler compiler;
     shaderc::CompileOptions options;
 
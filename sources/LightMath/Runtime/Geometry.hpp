@@ -0,0 +1,325 @@
+﻿#pragma once
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+#include "MatrixMath.hpp"
+
+namespace Light
+{
+    /**
+     * 轴对齐包围盒
+     */
+    struct AABB
+    {
+        static AABB FromCenterExtents(const float3 center, const float3 extents)
+        {
+            return {center - extents, center + extents};
+        }
+
+        float3 min;
+        float3 max;
+
+        float3 GetCenter() const { return (min + max) * 0.5f; }
+        /**
+         * 包围盒的半尺寸
+         * @return
+         */
+        float3 GetExtents() const { return (max - min) * 0.5f; }
+
+        bool Contains(const float3 point) const
+        {
+            return point.x >= min.x && point.x <= max.x &&
+                point.y >= min.y && point.y <= max.y &&
+                point.z >= min.z && point.z <= max.z;
+        }
+        bool Intersects(const AABB& other) const
+        {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                min.y <= other.max.y && max.y >= other.min.y &&
+                min.z <= other.max.z && max.z >= other.min.z;
+        }
+        /**
+         * 计算经过变换后的包围盒，结果仍是轴对齐的，因此可能比实际范围更大
+         * @param matrix 仿射变换矩阵
+         * @return
+         */
+        AABB Transform(const float4x4& matrix) const
+        {
+            //中心点正常变换，半尺寸按矩阵各元素的绝对值变换
+            float3 center = GetCenter();
+            float3 extents = GetExtents();
+            float3 newCenter = {
+                matrix._m00 * center.x + matrix._m01 * center.y + matrix._m02 * center.z + matrix._m03,
+                matrix._m10 * center.x + matrix._m11 * center.y + matrix._m12 * center.z + matrix._m13,
+                matrix._m20 * center.x + matrix._m21 * center.y + matrix._m22 * center.z + matrix._m23,
+            };
+            float3 newExtents = {
+                ::abs(matrix._m00) * extents.x + ::abs(matrix._m01) * extents.y + ::abs(matrix._m02) * extents.z,
+                ::abs(matrix._m10) * extents.x + ::abs(matrix._m11) * extents.y + ::abs(matrix._m12) * extents.z,
+                ::abs(matrix._m20) * extents.x + ::abs(matrix._m21) * extents.y + ::abs(matrix._m22) * extents.z,
+            };
+            return FromCenterExtents(newCenter, newExtents);
+        }
+    };
+
+    /**
+     * 包围球
+     */
+    struct Sphere
+    {
+        float3 center;
+        float radius;
+
+        bool Contains(const float3 point) const
+        {
+            return lengthsq(point - center) <= radius * radius;
+        }
+        bool Intersects(const Sphere& other) const
+        {
+            float radiusSum = radius + other.radius;
+            return lengthsq(other.center - center) <= radiusSum * radiusSum;
+        }
+    };
+
+    /**
+     * 平面，由法线和距离表示，平面上的点p满足 dot(normal, p) + distance = 0
+     */
+    struct Plane
+    {
+        /**
+         * 由平面方程 ax + by + cz + d = 0 的系数创建平面，并归一化法线
+         * @param coefficients (a,b,c,d)
+         * @return
+         */
+        static Plane FromCoefficients(const float4 coefficients)
+        {
+            float3 normal = {coefficients.x, coefficients.y, coefficients.z};
+            float inverseLength = 1 / length(normal);
+            return {normal * inverseLength, coefficients.w * inverseLength};
+        }
+
+        float3 normal;
+        float distance;
+
+        /**
+         * 点到平面的有向距离，在法线所指一侧为正
+         * @param point
+         * @return
+         */
+        float GetDistance(const float3 point) const
+        {
+            //按分量依次累加而不使用dot，与批量剔除中SIMD实现的运算顺序一致，保证两者对边界上的物体判断相同
+            return normal.x * point.x + normal.y * point.y + normal.z * point.z + distance;
+        }
+        /**
+         * 包围盒在法线方向上的投影半径，运算顺序同GetDistance
+         * @param extents 包围盒的半边长
+         * @return
+         */
+        float GetProjectedRadius(const float3 extents) const
+        {
+            return std::abs(normal.x) * extents.x + std::abs(normal.y) * extents.y + std::abs(normal.z) * extents.z;
+        }
+    };
+
+    /**
+     * 视锥体，由6个法线朝内的平面构成
+     */
+    struct Frustum
+    {
+        /**
+         * 从观察投影矩阵中提取视锥体平面，剪辑空间需遵从Ortho和Perspective的约定，即xy为[-1,1]，深度为[0,1]
+         * @param viewProjection 观察投影矩阵，若为模型观察投影矩阵则得到模型空间的视锥体
+         * @return
+         */
+        static Frustum FromMatrix(const float4x4& viewProjection)
+        {
+            const float4x4& m = viewProjection;
+            float4 row0 = {m._m00, m._m01, m._m02, m._m03};
+            float4 row1 = {m._m10, m._m11, m._m12, m._m13};
+            float4 row2 = {m._m20, m._m21, m._m22, m._m23};
+            float4 row3 = {m._m30, m._m31, m._m32, m._m33};
+
+            return {
+                Plane::FromCoefficients(row3 + row0), //左
+                Plane::FromCoefficients(row3 - row0), //右
+                Plane::FromCoefficients(row3 + row1), //下
+                Plane::FromCoefficients(row3 - row1), //上
+                Plane::FromCoefficients(row2), //近
+                Plane::FromCoefficients(row3 - row2), //远
+            };
+        }
+
+        Plane planes[6];
+
+        bool Intersects(const AABB& box) const
+        {
+            float3 center = box.GetCenter();
+            float3 extents = box.GetExtents();
+            for (const Plane& plane : planes)
+            {
+                if (plane.GetDistance(center) + plane.GetProjectedRadius(extents) < 0)
+                    return false;
+            }
+            return true;
+        }
+        bool Intersects(const Sphere& sphere) const
+        {
+            for (const Plane& plane : planes)
+            {
+                if (plane.GetDistance(sphere.center) + sphere.radius < 0)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    //批量剔除时会将连续的包围体直接作为float数组读取
+    static_assert(sizeof(AABB) == sizeof(float) * 6 && sizeof(Sphere) == sizeof(float) * 4);
+
+    /**
+     * 批量进行包围盒视锥体剔除
+     *
+     * 内部每次迭代处理8个包围盒，将其转为按分量存放后同时与各平面测试。<br/>
+     * 测试是保守的，即少数位于视锥体外但靠近角落的物体可能被判断为可见。
+     * @param frustum
+     * @param boxes
+     * @param visibilityMasks 可见性位掩码，第i个包围盒可见时第i/32个元素的第i%32位为1，长度不能小于(boxes.size()+31)/32
+     */
+    inline void CullAABBs(const Frustum& frustum, const std::span<const AABB> boxes, const std::span<uint32_t> visibilityMasks)
+    {
+        assert(visibilityMasks.size() * 32 >= boxes.size() && "可见性位掩码长度不足！");
+
+        const size_t count = boxes.size();
+        std::fill(visibilityMasks.begin(), visibilityMasks.begin() + static_cast<std::ptrdiff_t>((count + 31) / 32), 0);
+
+        size_t i = 0;
+#if Light_Math_SSE
+        __m128 planes[6][4];
+        __m128 absNormals[6][3];
+        for (int p = 0; p < 6; p++)
+        {
+            const Plane& plane = frustum.planes[p];
+            planes[p][0] = _mm_set1_ps(plane.normal.x);
+            planes[p][1] = _mm_set1_ps(plane.normal.y);
+            planes[p][2] = _mm_set1_ps(plane.normal.z);
+            planes[p][3] = _mm_set1_ps(plane.distance);
+            absNormals[p][0] = _mm_set1_ps(::abs(plane.normal.x));
+            absNormals[p][1] = _mm_set1_ps(::abs(plane.normal.y));
+            absNormals[p][2] = _mm_set1_ps(::abs(plane.normal.z));
+        }
+
+        auto cull4 = [&planes,&absNormals](const AABB* source)
+        {
+            //每两个包围盒恰为4个三维向量(min0,max0,min1,max1)
+            const float* data = source->min.data;
+            __m128 xs0, ys0, zs0, xs1, ys1, zs1;
+            SIMD::Deinterleave3(_mm_loadu_ps(data), _mm_loadu_ps(data + 4), _mm_loadu_ps(data + 8), xs0, ys0, zs0);
+            SIMD::Deinterleave3(_mm_loadu_ps(data + 12), _mm_loadu_ps(data + 16), _mm_loadu_ps(data + 20), xs1, ys1, zs1);
+
+            const __m128 half = _mm_set1_ps(0.5f);
+            __m128 minX = _mm_shuffle_ps(xs0, xs1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 maxX = _mm_shuffle_ps(xs0, xs1, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 minY = _mm_shuffle_ps(ys0, ys1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 maxY = _mm_shuffle_ps(ys0, ys1, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 minZ = _mm_shuffle_ps(zs0, zs1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 maxZ = _mm_shuffle_ps(zs0, zs1, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+            __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+            __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+            __m128 extentsX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+            __m128 extentsY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+            __m128 extentsZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < 6; p++)
+            {
+                __m128 distance = _mm_mul_ps(planes[p][0], centerX);
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][1], centerY));
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][2], centerZ));
+                distance = _mm_add_ps(distance, planes[p][3]);
+                __m128 radius = _mm_mul_ps(absNormals[p][0], extentsX);
+                radius = _mm_add_ps(radius, _mm_mul_ps(absNormals[p][1], extentsY));
+                radius = _mm_add_ps(radius, _mm_mul_ps(absNormals[p][2], extentsZ));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+            return ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xF;
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint32_t mask = cull4(boxes.data() + i) | cull4(boxes.data() + i + 4) << 4;
+            visibilityMasks[i / 32] |= mask << (i % 32);
+        }
+        for (; i + 4 <= count; i += 4)
+            visibilityMasks[i / 32] |= cull4(boxes.data() + i) << (i % 32);
+#endif
+        for (; i < count; i++)
+        {
+            if (frustum.Intersects(boxes[i]))
+                visibilityMasks[i / 32] |= 1u << (i % 32);
+        }
+    }
+    /**
+     * 批量进行包围球视锥体剔除，用法同CullAABBs
+     * @param frustum
+     * @param spheres
+     * @param visibilityMasks
+     */
+    inline void CullSpheres(const Frustum& frustum, const std::span<const Sphere> spheres, const std::span<uint32_t> visibilityMasks)
+    {
+        assert(visibilityMasks.size() * 32 >= spheres.size() && "可见性位掩码长度不足！");
+
+        const size_t count = spheres.size();
+        std::fill(visibilityMasks.begin(), visibilityMasks.begin() + static_cast<std::ptrdiff_t>((count + 31) / 32), 0);
+
+        size_t i = 0;
+#if Light_Math_SSE
+        __m128 planes[6][4];
+        for (int p = 0; p < 6; p++)
+        {
+            const Plane& plane = frustum.planes[p];
+            planes[p][0] = _mm_set1_ps(plane.normal.x);
+            planes[p][1] = _mm_set1_ps(plane.normal.y);
+            planes[p][2] = _mm_set1_ps(plane.normal.z);
+            planes[p][3] = _mm_set1_ps(plane.distance);
+        }
+
+        auto cull4 = [&planes](const Sphere* source)
+        {
+            //包围球恰为4个float，转置后即为按分量存放
+            const float* data = source->center.data;
+            __m128 xs = _mm_loadu_ps(data);
+            __m128 ys = _mm_loadu_ps(data + 4);
+            __m128 zs = _mm_loadu_ps(data + 8);
+            __m128 radiuses = _mm_loadu_ps(data + 12);
+            _MM_TRANSPOSE4_PS(xs, ys, zs, radiuses);
+
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < 6; p++)
+            {
+                __m128 distance = _mm_mul_ps(planes[p][0], xs);
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][1], ys));
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][2], zs));
+                distance = _mm_add_ps(distance, planes[p][3]);
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radiuses), _mm_setzero_ps()));
+            }
+            return ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xF;
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint32_t mask = cull4(spheres.data() + i) | cull4(spheres.data() + i + 4) << 4;
+            visibilityMasks[i / 32] |= mask << (i % 32);
+        }
+        for (; i + 4 <= count; i += 4)
+            visibilityMasks[i / 32] |= cull4(spheres.data() + i) << (i % 32);
+#endif
+        for (; i < count; i++)
+        {
+            if (frustum.Intersects(spheres[i]))
+                visibilityMasks[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
@@ -9,6 +9,9 @@ namespace Light
     using float3x3 = matrix<float, 3, 3>;
     using float4x4 = matrix<float, 4, 4>;
 
+    //四元数相关的矩阵函数定义在Quaternion.hpp中
+    struct quaternion;
+
     template <class Type>
     struct vector<Type, 3 * 3>
     {
@@ -21,32 +24,26 @@ namespace Light
         {
             vector<Type, 3> rad = radians(degree);
 
-            float cosX = ::cos(rad.x);
-            float sinX = ::sin(rad.x);
-            vector xRotate = {
-                1, 0, 0,
-                0, cosX, -sinX,
-                0, sinX, cosX,
-            };
-
-            float cosY = ::cos(rad.y);
-            float sinY = ::sin(rad.y);
-            vector yRotate = {
-                cosY, 0, sinY,
-                0, 1, 0,
-                -sinY, 0, cosY,
-            };
+            //等价于 mul(yRotate, mul(xRotate, zRotate)) ，即依次绕z轴、x轴、y轴旋转，但直接展开了矩阵乘法
+            Type cosX = ::cos(rad.x);
+            Type sinX = ::sin(rad.x);
+            Type cosY = ::cos(rad.y);
+            Type sinY = ::sin(rad.y);
+            Type cosZ = ::cos(rad.z);
+            Type sinZ = ::sin(rad.z);
 
-            float cosZ = ::cos(rad.z);
-            float sinZ = ::sin(rad.z);
-            vector zRotate = {
-                cosZ, -sinZ, 0,
-                sinZ, cosZ, 0,
-                0, 0, 1,
+            return {
+                cosY * cosZ + sinY * sinX * sinZ, sinY * sinX * cosZ - cosY * sinZ, sinY * cosX,
+                cosX * sinZ, cosX * cosZ, -sinX,
+                cosY * sinX * sinZ - sinY * cosZ, sinY * sinZ + cosY * sinX * cosZ, cosY * cosX,
             };
-
-            return mul(yRotate, mul(xRotate, zRotate));
         }
+        /**
+         * 创建一个旋转矩阵
+         * @param rotation 单位四元数
+         * @return
+         */
+        constexpr static vector Rotate(const quaternion& rotation);
         /**
          * 创建一个缩放矩阵
          * @param scale 三维空间的各轴缩放
@@ -179,6 +176,7 @@ namespace Light
         {
             return vector<Type, 3 * 3>::Rotate(degree);
         }
+        constexpr static vector Rotate(const quaternion& rotation);
         constexpr static vector Scale(vector<Type, 3> scale)
         {
             return {
@@ -188,10 +186,25 @@ namespace Light
                 0, 0, 0, 1,
             };
         }
+        /**
+         * 创建一个依次进行缩放、旋转、平移的变换矩阵，即 mul(Translate(position), mul(Rotate(rotation), Scale(scale)))
+         * @param position
+         * @param rotation 基于欧拉角的三轴旋转角度
+         * @param scale
+         * @return
+         */
         constexpr static vector TRS(vector<Type, 3> position, vector<Type, 3> rotation, vector<Type, 3> scale)
         {
-            return mul(Translate(position), mul(Rotate(rotation), Scale(scale)));
+            return ComposeTRS(position, vector<Type, 3 * 3>::Rotate(rotation), scale);
         }
+        /**
+         * 创建一个依次进行缩放、旋转、平移的变换矩阵
+         * @param position
+         * @param rotation 单位四元数
+         * @param scale
+         * @return
+         */
+        constexpr static vector TRS(vector<Type, 3> position, const quaternion& rotation, vector<Type, 3> scale);
         /**
          * 创建一个正交投影矩阵，其剪辑空间遵从从右到左、从下到上都为[-1,1]，深度从近到远为[0-1]的约定。
          * @param right 视野范围半宽
@@ -368,5 +381,23 @@ namespace Light
         {
             return *reinterpret_cast<Matrix4x4Row<Type>*>(&data[i]);
         }
+
+    private:
+        /**
+         * 直接由旋转矩阵的各列乘以缩放并附加平移得到变换矩阵，省去两次4x4矩阵乘法
+         */
+        constexpr static vector ComposeTRS(const vector<Type, 3>& position, const vector<Type, 3 * 3>& rotation, const vector<Type, 3>& scale)
+        {
+            return {
+                rotation._m00 * scale.x, rotation._m01 * scale.y, rotation._m02 * scale.z, position.x,
+                rotation._m10 * scale.x, rotation._m11 * scale.y, rotation._m12 * scale.z, position.y,
+                rotation._m20 * scale.x, rotation._m21 * scale.y, rotation._m22 * scale.z, position.z,
+                0, 0, 0, 1
+            };
+        }
     };
+
+    //顶点格式和组件布局依赖这些类型按分量紧密排列，不能引入额外的对齐填充
+    static_assert(sizeof(float4) == sizeof(float) * 4 && alignof(float4) == alignof(float));
+    static_assert(sizeof(float4x4) == sizeof(float) * 16 && alignof(float4x4) == alignof(float));
 }
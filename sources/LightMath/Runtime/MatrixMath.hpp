@@ -55,14 +55,17 @@ constexpr matrix<Type, Row, Column> adjoint(const matrix<Type, Row, Column>& m)\
     return transpose(cofactor_matrix(m));\
 }
 
-#define MakeMatrixFunctions(Type,Row,Column)\
-Light_MakeVectorFunctions_Decimals(Type, (Row) * (Column))\
-MakeMatrixFunction_Transpose(Type,Row,Column)\
+#define MakeMatrixFunctions_Cofactor(Type,Row,Column)\
 MakeMatrixFunction_Cofactor(Type,Row,Column)\
 MakeMatrixFunction_CofactorDeterminant(Type,Row,Column)\
 MakeMatrixFunction_CofactorMatrix(Type,Row,Column)\
 MakeMatrixFunction_Adjoint(Type,Row,Column)
 
+#define MakeMatrixFunctions(Type,Row,Column)\
+Light_MakeVectorFunctions_Decimals(Type, (Row) * (Column))\
+MakeMatrixFunction_Transpose(Type,Row,Column)\
+MakeMatrixFunctions_Cofactor(Type,Row,Column)
+
 
     template <class Type>
     constexpr Type determinant(const matrix<Type, 2, 2>& m)
@@ -80,86 +83,135 @@ MakeMatrixFunction_Adjoint(Type,Row,Column)
     template <class Type>
     constexpr Type determinant(const matrix<Type, 4, 4>& m)
     {
-        constexpr int permutations[24][5] = {
-            {0, 1, 2, 3, 1},
-            {0, 1, 3, 2, -1},
-            {0, 2, 1, 3, -1},
-            {0, 2, 3, 1, 1},
-            {0, 3, 1, 2, 1},
-            {0, 3, 2, 1, -1},
-
-            {1, 0, 2, 3, -1},
-            {1, 0, 3, 2, 1},
-            {1, 2, 0, 3, 1},
-            {1, 2, 3, 0, -1},
-            {1, 3, 0, 2, -1},
-            {1, 3, 2, 0, 1},
-
-            {2, 0, 1, 3, 1},
-            {2, 0, 3, 1, -1},
-            {2, 1, 0, 3, -1},
-            {2, 1, 3, 0, 1},
-            {2, 3, 0, 1, 1},
-            {2, 3, 1, 0, -1},
-
-            {3, 0, 1, 2, -1},
-            {3, 0, 2, 1, 1},
-            {3, 1, 0, 2, 1},
-            {3, 1, 2, 0, -1},
-            {3, 2, 0, 1, -1},
-            {3, 2, 1, 0, 1},
-        };
+        //按上下两组各两行展开（拉普拉斯展开），6对2x2子式的乘积之和即为行列式
+        Type s0 = m._m00 * m._m11 - m._m10 * m._m01;
+        Type s1 = m._m00 * m._m12 - m._m10 * m._m02;
+        Type s2 = m._m00 * m._m13 - m._m10 * m._m03;
+        Type s3 = m._m01 * m._m12 - m._m11 * m._m02;
+        Type s4 = m._m01 * m._m13 - m._m11 * m._m03;
+        Type s5 = m._m02 * m._m13 - m._m12 * m._m03;
 
-        Type total = 0;
-        for (const auto& permutation : permutations)
-        {
-            Type value = static_cast<Type>(permutation[4]);
-            for (int j = 0; j < 4; j++)
-                value *= m.data[j + permutation[j] * 4];
-            total += value;
-        }
-        return total;
+        Type c0 = m._m20 * m._m31 - m._m30 * m._m21;
+        Type c1 = m._m20 * m._m32 - m._m30 * m._m22;
+        Type c2 = m._m20 * m._m33 - m._m30 * m._m23;
+        Type c3 = m._m21 * m._m32 - m._m31 * m._m22;
+        Type c4 = m._m21 * m._m33 - m._m31 * m._m23;
+        Type c5 = m._m22 * m._m33 - m._m32 * m._m23;
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
     }
 
+    template <class Type>
+    constexpr matrix<Type, 3, 3> inverse(const matrix<Type, 3, 3>& m)
+    {
+        Type cofactor00 = m._m11 * m._m22 - m._m12 * m._m21;
+        Type cofactor01 = m._m12 * m._m20 - m._m10 * m._m22;
+        Type cofactor02 = m._m10 * m._m21 - m._m11 * m._m20;
+        Type inverseDeterminant = 1 / (m._m00 * cofactor00 + m._m01 * cofactor01 + m._m02 * cofactor02);
+
+        return matrix<Type, 3, 3>{
+            cofactor00 * inverseDeterminant,
+            (m._m02 * m._m21 - m._m01 * m._m22) * inverseDeterminant,
+            (m._m01 * m._m12 - m._m02 * m._m11) * inverseDeterminant,
+            cofactor01 * inverseDeterminant,
+            (m._m00 * m._m22 - m._m02 * m._m20) * inverseDeterminant,
+            (m._m02 * m._m10 - m._m00 * m._m12) * inverseDeterminant,
+            cofactor02 * inverseDeterminant,
+            (m._m01 * m._m20 - m._m00 * m._m21) * inverseDeterminant,
+            (m._m00 * m._m11 - m._m01 * m._m10) * inverseDeterminant,
+        };
+    }
+    /**
+     * 求任意可逆矩阵的逆矩阵
+     *
+     * 与行列式一样利用上下两组2x2子式直接求出伴随矩阵，结果与 adjoint(m) / determinant(m) 一致，但无需逐个构建余子式。
+     * @param m
+     * @return
+     */
     template <class Type>
     constexpr matrix<Type, 4, 4> inverse(const matrix<Type, 4, 4>& m)
     {
-        Type determinant00 = cofactor_determinant(m, 0, 0);
-        Type determinant10 = cofactor_determinant(m, 1, 0);
-        Type determinant20 = cofactor_determinant(m, 2, 0);
-        Type determinant30 = cofactor_determinant(m, 3, 0);
-
-        Type determinant01 = cofactor_determinant(m, 0, 1);
-        Type determinant11 = cofactor_determinant(m, 1, 1);
-        Type determinant21 = cofactor_determinant(m, 2, 1);
-        Type determinant31 = cofactor_determinant(m, 3, 1);
-
-        Type determinant02 = cofactor_determinant(m, 0, 2);
-        Type determinant12 = cofactor_determinant(m, 1, 2);
-        Type determinant22 = cofactor_determinant(m, 2, 2);
-        Type determinant32 = cofactor_determinant(m, 3, 2);
-
-        Type determinant03 = cofactor_determinant(m, 0, 3);
-        Type determinant13 = cofactor_determinant(m, 1, 3);
-        Type determinant23 = cofactor_determinant(m, 2, 3);
-        Type determinant33 = cofactor_determinant(m, 3, 3);
+        Type s0 = m._m00 * m._m11 - m._m10 * m._m01;
+        Type s1 = m._m00 * m._m12 - m._m10 * m._m02;
+        Type s2 = m._m00 * m._m13 - m._m10 * m._m03;
+        Type s3 = m._m01 * m._m12 - m._m11 * m._m02;
+        Type s4 = m._m01 * m._m13 - m._m11 * m._m03;
+        Type s5 = m._m02 * m._m13 - m._m12 * m._m03;
+
+        Type c0 = m._m20 * m._m31 - m._m30 * m._m21;
+        Type c1 = m._m20 * m._m32 - m._m30 * m._m22;
+        Type c2 = m._m20 * m._m33 - m._m30 * m._m23;
+        Type c3 = m._m21 * m._m32 - m._m31 * m._m22;
+        Type c4 = m._m21 * m._m33 - m._m31 * m._m23;
+        Type c5 = m._m22 * m._m33 - m._m32 * m._m23;
+
+        Type determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 
         matrix<Type, 4, 4> adjoint = {
-            determinant00, determinant10, determinant20, determinant30,
-            determinant01, determinant11, determinant21, determinant31,
-            determinant02, determinant12, determinant22, determinant32,
-            determinant03, determinant13, determinant23, determinant33,
-        };
+            m._m11 * c5 - m._m12 * c4 + m._m13 * c3,
+            -m._m01 * c5 + m._m02 * c4 - m._m03 * c3,
+            m._m31 * s5 - m._m32 * s4 + m._m33 * s3,
+            -m._m21 * s5 + m._m22 * s4 - m._m23 * s3,
 
-        Type determinant =
-            m._m00 * determinant00 +
-            m._m01 * determinant01 +
-            m._m02 * determinant02 +
-            m._m03 * determinant03;
+            -m._m10 * c5 + m._m12 * c2 - m._m13 * c1,
+            m._m00 * c5 - m._m02 * c2 + m._m03 * c1,
+            -m._m30 * s5 + m._m32 * s2 - m._m33 * s1,
+            m._m20 * s5 - m._m22 * s2 + m._m23 * s1,
+
+            m._m10 * c4 - m._m11 * c2 + m._m13 * c0,
+            -m._m00 * c4 + m._m01 * c2 - m._m03 * c0,
+            m._m30 * s4 - m._m31 * s2 + m._m33 * s0,
+            -m._m20 * s4 + m._m21 * s2 - m._m23 * s0,
+
+            -m._m10 * c3 + m._m11 * c1 - m._m12 * c0,
+            m._m00 * c3 - m._m01 * c1 + m._m02 * c0,
+            -m._m30 * s3 + m._m31 * s1 - m._m32 * s0,
+            m._m20 * s3 - m._m21 * s1 + m._m22 * s0,
+        };
 
         matrix<Type, 4, 4> inverse = adjoint / determinant;
         return inverse;
     }
+    /**
+     * 求仿射矩阵（最后一行为0,0,0,1，如TRS矩阵）的逆矩阵
+     *
+     * 仿射矩阵的逆等于左上3x3部分的逆，再加上经其变换后取反的平移。
+     * @param m
+     * @return
+     */
+    template <class Type>
+    constexpr matrix<Type, 4, 4> inverse_affine(const matrix<Type, 4, 4>& m)
+    {
+        matrix<Type, 3, 3> linear = inverse(matrix<Type, 3, 3>{
+            m._m00, m._m01, m._m02,
+            m._m10, m._m11, m._m12,
+            m._m20, m._m21, m._m22,
+        });
+
+        return {
+            linear._m00, linear._m01, linear._m02, -(linear._m00 * m._m03 + linear._m01 * m._m13 + linear._m02 * m._m23),
+            linear._m10, linear._m11, linear._m12, -(linear._m10 * m._m03 + linear._m11 * m._m13 + linear._m12 * m._m23),
+            linear._m20, linear._m21, linear._m22, -(linear._m20 * m._m03 + linear._m21 * m._m13 + linear._m22 * m._m23),
+            0, 0, 0, 1,
+        };
+    }
+    /**
+     * 求刚体变换矩阵（仅包含旋转和平移，如相机的观察矩阵）的逆矩阵
+     *
+     * 旋转矩阵是正交矩阵，其逆即为转置，因此无需求行列式。
+     * @param m
+     * @return
+     */
+    template <class Type>
+    constexpr matrix<Type, 4, 4> inverse_rigid(const matrix<Type, 4, 4>& m)
+    {
+        return {
+            m._m00, m._m10, m._m20, -(m._m00 * m._m03 + m._m10 * m._m13 + m._m20 * m._m23),
+            m._m01, m._m11, m._m21, -(m._m01 * m._m03 + m._m11 * m._m13 + m._m21 * m._m23),
+            m._m02, m._m12, m._m22, -(m._m02 * m._m03 + m._m12 * m._m13 + m._m22 * m._m23),
+            0, 0, 0, 1,
+        };
+    }
 
     template <class Type>
     constexpr matrix<Type, 3, 3> mul(const matrix<Type, 3, 3>& left, const matrix<Type, 3, 3>& right)
@@ -218,6 +270,61 @@ MakeMatrixFunction_Adjoint(Type,Row,Column)
         };
     }
 
+#if Light_Math_SSE
+    //按列存储的矩阵每列恰好对应一个SSE寄存器，矩阵乘法可转为四次线性组合
+
+    inline float4x4 mul(const float4x4& left, const float4x4& right)
+    {
+        const __m128 leftColumns[4] = {
+            _mm_loadu_ps(left.data + 0),
+            _mm_loadu_ps(left.data + 4),
+            _mm_loadu_ps(left.data + 8),
+            _mm_loadu_ps(left.data + 12),
+        };
+        float4x4 matrix;
+        for (int i = 0; i < 16; i += 4)
+            _mm_storeu_ps(matrix.data + i, SIMD::MulColumn(leftColumns, _mm_loadu_ps(right.data + i)));
+        return matrix;
+    }
+    constexpr float4 mul(const float4x4& left, const float4& right)
+    {
+        if (std::is_constant_evaluated())
+            return mul<float>(left, right);
+
+        const __m128 leftColumns[4] = {
+            _mm_loadu_ps(left.data + 0),
+            _mm_loadu_ps(left.data + 4),
+            _mm_loadu_ps(left.data + 8),
+            _mm_loadu_ps(left.data + 12),
+        };
+        float4 vector;
+        _mm_storeu_ps(vector.data, SIMD::MulColumn(leftColumns, _mm_loadu_ps(right.data)));
+        return vector;
+    }
+    constexpr float4x4 transpose(const float4x4& m)
+    {
+        float4x4 result;
+        if (std::is_constant_evaluated())
+        {
+            for (int row = 0; row < 4; row++)
+                for (int column = 0; column < 4; column++)
+                    result.data[column + row * 4] = m.data[row + column * 4];
+            return result;
+        }
+
+        __m128 column0 = _mm_loadu_ps(m.data + 0);
+        __m128 column1 = _mm_loadu_ps(m.data + 4);
+        __m128 column2 = _mm_loadu_ps(m.data + 8);
+        __m128 column3 = _mm_loadu_ps(m.data + 12);
+        _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+        _mm_storeu_ps(result.data + 0, column0);
+        _mm_storeu_ps(result.data + 4, column1);
+        _mm_storeu_ps(result.data + 8, column2);
+        _mm_storeu_ps(result.data + 12, column3);
+        return result;
+    }
+#endif
+
     template <class Type>
     constexpr std::string to_string(const matrix<Type, 3, 3>& m)
     {
@@ -241,7 +348,12 @@ MakeMatrixFunction_Adjoint(Type,Row,Column)
     }
 
     MakeMatrixFunctions(float, 3, 3)
+#if Light_Math_SSE
+    Light_MakeVectorFunctions_DecimalsSIMD(4 * 4)
+    MakeMatrixFunctions_Cofactor(float, 4, 4)
+#else
     MakeMatrixFunctions(float, 4, 4)
+#endif
 
     Light_MakeVectorFunction_All(bool, 3*3)
     Light_MakeVectorFunction_All(bool, 4*4)
@@ -0,0 +1,297 @@
+﻿#pragma once
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "VectorMath.hpp"
+
+//用于紧凑存储的低精度数值类型，如网格顶点和需要大量保存的组件数据
+//这些类型只负责存储，计算时应先转为float向量
+
+namespace Light
+{
+    /**
+     * IEEE 754 半精度浮点数
+     */
+    struct half
+    {
+        /**
+         * 将float转为半精度浮点数的位表示，舍入方式为向最近的偶数舍入，与F16C指令一致
+         * @param value
+         * @return
+         */
+        constexpr static uint16_t ToBits(const float value)
+        {
+            const uint32_t bits = std::bit_cast<uint32_t>(value);
+            const uint32_t sign = (bits >> 16) & 0x8000;
+            const uint32_t exponent = (bits >> 23) & 0xFF;
+            uint32_t mantissa = bits & 0x7FFFFF;
+
+            //无穷大和NaN，NaN需保证尾数不为零
+            if (exponent == 0xFF)
+                return static_cast<uint16_t>(sign | 0x7C00 | (mantissa != 0 ? 0x200 | (mantissa >> 13) : 0));
+
+            const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+            //超出表示范围，溢出为无穷大
+            if (halfExponent >= 0x1F)
+                return static_cast<uint16_t>(sign | 0x7C00);
+            //低于规格化范围，转为非规格化数或零
+            if (halfExponent <= 0)
+            {
+                if (halfExponent < -10)
+                    return static_cast<uint16_t>(sign);
+
+                mantissa |= 0x800000; //补上隐含的最高位
+                const int shift = 14 - halfExponent;
+                uint32_t result = mantissa >> shift;
+                const uint32_t remainder = mantissa & ((1u << shift) - 1);
+                const uint32_t halfway = 1u << (shift - 1);
+                if (remainder > halfway || (remainder == halfway && (result & 1)))
+                    result++;
+                return static_cast<uint16_t>(sign | result);
+            }
+
+            //尾数舍入产生的进位会自然地进入指数位
+            uint32_t result = static_cast<uint32_t>(halfExponent) << 10 | mantissa >> 13;
+            const uint32_t remainder = mantissa & 0x1FFF;
+            if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+                result++;
+            return static_cast<uint16_t>(sign | result);
+        }
+        /**
+         * 将半精度浮点数的位表示转为float，该转换是精确的
+         * @param bits
+         * @return
+         */
+        constexpr static float FromBits(const uint16_t bits)
+        {
+            const uint32_t sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+            int exponent = bits >> 10 & 0x1F;
+            uint32_t mantissa = bits & 0x3FF;
+
+            if (exponent == 0x1F) //无穷大和NaN
+                return std::bit_cast<float>(sign | 0x7F800000 | mantissa << 13);
+            if (exponent == 0)
+            {
+                if (mantissa == 0) //正负零
+                    return std::bit_cast<float>(sign);
+
+                //非规格化数，在float中可以规格化表示
+                exponent = 1;
+                while ((mantissa & 0x400) == 0)
+                {
+                    mantissa <<= 1;
+                    exponent--;
+                }
+                mantissa &= 0x3FF;
+            }
+            return std::bit_cast<float>(sign | static_cast<uint32_t>(exponent + 127 - 15) << 23 | mantissa << 13);
+        }
+
+        uint16_t bits;
+
+        constexpr half() = default;
+        constexpr explicit half(const float value)
+            : bits(ToBits(value))
+        {
+        }
+
+        constexpr operator float() const
+        {
+            return FromBits(bits);
+        }
+    };
+
+    /**
+     * 归一化整数，将[0,1]（无符号）或[-1,1]（有符号）范围内的小数映射到整数的完整范围上存储
+     *
+     * 转换规则与D3D和Vulkan的UNORM/SNORM格式一致，因此可直接作为顶点属性上传。
+     * @tparam Storage 用于存储的整数类型
+     */
+    template <class Storage>
+        requires std::is_integral_v<Storage>
+    struct norm
+    {
+        constexpr static float MaxValue = static_cast<float>(std::numeric_limits<Storage>::max());
+
+        Storage value;
+
+        constexpr norm() = default;
+        /**
+         * @param value 超出表示范围的值会被截断
+         */
+        constexpr explicit norm(const float value)
+        {
+            if constexpr (std::is_signed_v<Storage>)
+            {
+                const float scaled = std::clamp(value, -1.0f, 1.0f) * MaxValue;
+                this->value = static_cast<Storage>(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+            }
+            else
+            {
+                this->value = static_cast<Storage>(std::clamp(value, 0.0f, 1.0f) * MaxValue + 0.5f);
+            }
+        }
+
+        constexpr operator float() const
+        {
+            //有符号时最小值比-MaxValue还小1，规定其同样表示-1
+            if constexpr (std::is_signed_v<Storage>)
+                return std::max(static_cast<float>(value) / MaxValue, -1.0f);
+            else
+                return static_cast<float>(value) / MaxValue;
+        }
+    };
+
+    using snorm8 = norm<int8_t>;
+    using unorm8 = norm<uint8_t>;
+    using snorm16 = norm<int16_t>;
+    using unorm16 = norm<uint16_t>;
+
+    using half2 = vector<half, 2>;
+    using half3 = vector<half, 3>;
+    using half4 = vector<half, 4>;
+    using snorm8x2 = vector<snorm8, 2>;
+    using snorm8x4 = vector<snorm8, 4>;
+    using unorm8x2 = vector<unorm8, 2>;
+    using unorm8x4 = vector<unorm8, 4>;
+    using snorm16x2 = vector<snorm16, 2>;
+    using snorm16x4 = vector<snorm16, 4>;
+    using unorm16x2 = vector<unorm16, 2>;
+    using unorm16x4 = vector<unorm16, 4>;
+
+    template <class Type>
+    concept PackedNumber = std::is_same_v<Type, half> || std::is_same_v<Type, snorm8> || std::is_same_v<Type, unorm8> ||
+        std::is_same_v<Type, snorm16> || std::is_same_v<Type, unorm16>;
+
+    /**
+     * 将float向量压缩为低精度向量
+     * @tparam Type 压缩后的分量类型
+     * @param value
+     * @return
+     */
+    template <PackedNumber Type, int Number>
+    constexpr vector<Type, Number> pack(const vector<float, Number>& value)
+    {
+        vector<Type, Number> result;
+        for (int i = 0; i < Number; i++)
+            result.data[i] = Type(value.data[i]);
+        return result;
+    }
+    /**
+     * 将低精度向量还原为float向量
+     * @param value
+     * @return
+     */
+    template <PackedNumber Type, int Number>
+    constexpr vector<float, Number> unpack(const vector<Type, Number>& value)
+    {
+        vector<float, Number> result;
+        for (int i = 0; i < Number; i++)
+            result.data[i] = static_cast<float>(value.data[i]);
+        return result;
+    }
+
+    /**
+     * 基于八面体映射压缩的单位向量，仅占4字节，常用于存储法线和切线
+     *
+     * 将单位球面投影到八面体上再展开为正方形，因此只需两个分量，且在球面上的精度分布比较均匀。
+     */
+    struct octahedral
+    {
+        /**
+         * @param direction 需为单位向量
+         * @return
+         */
+        static octahedral Encode(const float3 direction)
+        {
+            const float sum = ::abs(direction.x) + ::abs(direction.y) + ::abs(direction.z);
+            float2 point = {direction.x / sum, direction.y / sum};
+            //下半球沿对角线折叠到正方形的四个角上
+            if (direction.z < 0)
+            {
+                point = {
+                    (1 - ::abs(point.y)) * (point.x >= 0 ? 1.0f : -1.0f),
+                    (1 - ::abs(point.x)) * (point.y >= 0 ? 1.0f : -1.0f),
+                };
+            }
+
+            octahedral result;
+            result.value = pack<snorm16>(point);
+            return result;
+        }
+
+        snorm16x2 value;
+
+        /**
+         * @return 解码得到的单位向量
+         */
+        float3 Decode() const
+        {
+            const float2 point = unpack(value);
+            float3 direction = {point.x, point.y, 1 - ::abs(point.x) - ::abs(point.y)};
+            //还原被折叠的下半球
+            const float fold = std::max(-direction.z, 0.0f);
+            direction.x += direction.x >= 0 ? -fold : fold;
+            direction.y += direction.y >= 0 ? -fold : fold;
+            return normalize(direction);
+        }
+    };
+
+    static_assert(sizeof(half4) == 8 && sizeof(unorm8x4) == 4 && sizeof(snorm16x4) == 8 && sizeof(octahedral) == 4);
+
+    /**
+     * 批量将float转为半精度浮点数，支持F16C指令集时每次迭代处理8个元素
+     *
+     * 多维向量数组可通过reinterpret_cast视为分量数组后传入。
+     * @param values
+     * @param outValues
+     */
+    inline void PackHalfs(const std::span<const float> values, const std::span<half> outValues)
+    {
+        assert(outValues.size() >= values.size() && "输出数组长度不足！");
+
+        const size_t count = values.size();
+        size_t i = 0;
+#if Light_Math_F16C
+        const float* source = values.data();
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i low = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+            const __m128i high = _mm_cvtps_ph(_mm_loadu_ps(source + i + 4), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outValues.data() + i), _mm_unpacklo_epi64(low, high));
+        }
+        for (; i + 4 <= count; i += 4)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(outValues.data() + i), _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+        for (; i < count; i++)
+            outValues[i] = half(values[i]);
+    }
+    /**
+     * PackHalfs的逆操作
+     * @param values
+     * @param outValues
+     */
+    inline void UnpackHalfs(const std::span<const half> values, const std::span<float> outValues)
+    {
+        assert(outValues.size() >= values.size() && "输出数组长度不足！");
+
+        const size_t count = values.size();
+        size_t i = 0;
+#if Light_Math_F16C
+        float* destination = outValues.data();
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + i));
+            _mm_storeu_ps(destination + i, _mm_cvtph_ps(packed));
+            _mm_storeu_ps(destination + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(packed, packed)));
+        }
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(destination + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values.data() + i))));
+#endif
+        for (; i < count; i++)
+            outValues[i] = values[i];
+    }
+}
@@ -0,0 +1,247 @@
+﻿#pragma once
+#include "MatrixMath.hpp"
+
+namespace Light
+{
+    /**
+     * 四元数，用于表示三维旋转
+     *
+     * 仿照Unity的Mathematics包，数据存储在一个四维向量中，其中xyz为虚部，w为实部。
+     * 除特别说明外，函数均假定四元数为单位四元数。
+     */
+    struct quaternion
+    {
+        consteval static quaternion Identity()
+        {
+            return {0, 0, 0, 1};
+        }
+        /**
+         * 创建一个绕轴旋转的四元数
+         * @param axis 作为旋转轴的单位向量
+         * @param degree 旋转的角度
+         * @return
+         */
+        static quaternion AxisAngle(const float3 axis, const float degree)
+        {
+            float halfRad = radians(degree) * 0.5f;
+            float sinHalf = std::sin(halfRad);
+            return {axis.x * sinHalf, axis.y * sinHalf, axis.z * sinHalf, std::cos(halfRad)};
+        }
+        /**
+         * 由欧拉角创建四元数，与float3x3::Rotate的约定相同，即依次绕z轴、x轴、y轴旋转
+         * @param degree 基于欧拉角的三轴旋转角度
+         * @return
+         */
+        static quaternion Euler(const float3 degree)
+        {
+            float3 halfRad = radians(degree) * 0.5f;
+            float sinX = std::sin(halfRad.x);
+            float cosX = std::cos(halfRad.x);
+            float sinY = std::sin(halfRad.y);
+            float cosY = std::cos(halfRad.y);
+            float sinZ = std::sin(halfRad.z);
+            float cosZ = std::cos(halfRad.z);
+
+            //展开 qy * qx * qz
+            return {
+                sinX * cosY * cosZ + cosX * sinY * sinZ,
+                cosX * sinY * cosZ - sinX * cosY * sinZ,
+                cosX * cosY * sinZ - sinX * sinY * cosZ,
+                cosX * cosY * cosZ + sinX * sinY * sinZ,
+            };
+        }
+
+        float4 value;
+
+        constexpr quaternion()
+        {
+        }
+        constexpr quaternion(const float x, const float y, const float z, const float w)
+            : value(x, y, z, w)
+        {
+        }
+        constexpr explicit quaternion(const float4& value)
+            : value(value)
+        {
+        }
+        /**
+         * 由旋转矩阵创建四元数
+         * @param m 不含缩放的旋转矩阵
+         */
+        explicit quaternion(const float3x3& m)
+        {
+            //选取数值最大的分量求解，以避免除以接近零的数
+            float trace = m._m00 + m._m11 + m._m22;
+            if (trace > 0)
+            {
+                float s = std::sqrt(trace + 1) * 2;
+                value = {(m._m21 - m._m12) / s, (m._m02 - m._m20) / s, (m._m10 - m._m01) / s, 0.25f * s};
+            }
+            else if (m._m00 > m._m11 && m._m00 > m._m22)
+            {
+                float s = std::sqrt(1 + m._m00 - m._m11 - m._m22) * 2;
+                value = {0.25f * s, (m._m01 + m._m10) / s, (m._m02 + m._m20) / s, (m._m21 - m._m12) / s};
+            }
+            else if (m._m11 > m._m22)
+            {
+                float s = std::sqrt(1 + m._m11 - m._m00 - m._m22) * 2;
+                value = {(m._m01 + m._m10) / s, 0.25f * s, (m._m12 + m._m21) / s, (m._m02 - m._m20) / s};
+            }
+            else
+            {
+                float s = std::sqrt(1 + m._m22 - m._m00 - m._m11) * 2;
+                value = {(m._m02 + m._m20) / s, (m._m12 + m._m21) / s, 0.25f * s, (m._m10 - m._m01) / s};
+            }
+        }
+    };
+
+    constexpr float dot(const quaternion& a, const quaternion& b)
+    {
+        return dot(a.value, b.value);
+    }
+    inline float length(const quaternion& q)
+    {
+        return length(q.value);
+    }
+    inline quaternion normalize(const quaternion& q)
+    {
+        return quaternion(normalize(q.value));
+    }
+    /**
+     * 共轭四元数，对于单位四元数即为其逆
+     * @param q
+     * @return
+     */
+    constexpr quaternion conjugate(const quaternion& q)
+    {
+        return {-q.value.x, -q.value.y, -q.value.z, q.value.w};
+    }
+    /**
+     * 逆四元数，适用于非单位四元数
+     * @param q
+     * @return
+     */
+    constexpr quaternion inverse(const quaternion& q)
+    {
+        return quaternion(conjugate(q).value / dot(q, q));
+    }
+
+    /**
+     * 四元数乘法，结果表示先进行b旋转，再进行a旋转
+     * @param a
+     * @param b
+     * @return
+     */
+    constexpr quaternion mul(const quaternion& a, const quaternion& b)
+    {
+        return {
+            a.value.w * b.value.x + a.value.x * b.value.w + a.value.y * b.value.z - a.value.z * b.value.y,
+            a.value.w * b.value.y - a.value.x * b.value.z + a.value.y * b.value.w + a.value.z * b.value.x,
+            a.value.w * b.value.z + a.value.x * b.value.y - a.value.y * b.value.x + a.value.z * b.value.w,
+            a.value.w * b.value.w - a.value.x * b.value.x - a.value.y * b.value.y - a.value.z * b.value.z,
+        };
+    }
+    /**
+     * 使用四元数旋转向量
+     * @param q
+     * @param v
+     * @return
+     */
+    constexpr float3 mul(const quaternion& q, const float3& v)
+    {
+        //v' = v + 2w(u×v) + 2u×(u×v) ，其中u为四元数虚部
+        float3 u = {q.value.x, q.value.y, q.value.z};
+        float3 t = cross(u, v) * 2.0f;
+        return v + t * q.value.w + cross(u, t);
+    }
+
+    /**
+     * 归一化线性插值，速度不均匀但计算量小，适合插值角度较小的情况
+     * @param origin 起点
+     * @param destination 终点
+     * @param rate 插值比率
+     * @return
+     */
+    inline quaternion nlerp(const quaternion& origin, const quaternion& destination, const float rate)
+    {
+        //q与-q表示相同的旋转，取夹角较小的一侧插值
+        float4 target = destination.value;
+        if (dot(origin, destination) < 0)
+            target = -target;
+        return quaternion(normalize(lerp(origin.value, target, rate)));
+    }
+    /**
+     * 球面线性插值，以恒定角速度沿最短路径插值
+     * @param origin 起点
+     * @param destination 终点
+     * @param rate 插值比率
+     * @return
+     */
+    inline quaternion slerp(const quaternion& origin, const quaternion& destination, const float rate)
+    {
+        float cosAngle = dot(origin, destination);
+        float4 target = destination.value;
+        if (cosAngle < 0)
+        {
+            cosAngle = -cosAngle;
+            target = -target;
+        }
+
+        //夹角过小时sin接近零，退化为归一化线性插值
+        if (cosAngle > 0.9995f)
+            return quaternion(normalize(lerp(origin.value, target, rate)));
+
+        float angle = std::acos(cosAngle);
+        float sinAngle = std::sin(angle);
+        float originWeight = std::sin((1 - rate) * angle) / sinAngle;
+        float targetWeight = std::sin(rate * angle) / sinAngle;
+        return quaternion(origin.value * originWeight + target * targetWeight);
+    }
+
+    /**
+     * 将四元数转为欧拉角，与quaternion::Euler互逆
+     * @param q
+     * @return 基于欧拉角的三轴旋转角度
+     */
+    inline float3 euler(const quaternion& q)
+    {
+        float3x3 m = float3x3::Rotate(q);
+
+        //旋转矩阵中 m12 = -sin(x) ，且x为±90度时出现万向节死锁，此时将z轴旋转归入y轴
+        float sinX = std::clamp(-m._m12, -1.0f, 1.0f);
+        float x = std::asin(sinX);
+        if (std::abs(sinX) < 0.9999f)
+            return degrees(float3(x, std::atan2(m._m02, m._m22), std::atan2(m._m10, m._m11)));
+        return degrees(float3(x, std::atan2(-m._m20, m._m00), 0));
+    }
+
+    inline std::string to_string(const quaternion& q)
+    {
+        return to_string(q.value);
+    }
+
+    template <class Type>
+    constexpr vector<Type, 3 * 3> vector<Type, 3 * 3>::Rotate(const quaternion& rotation)
+    {
+        const float4& q = rotation.value;
+        Type xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        Type xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        Type wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        return {
+            1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy),
+            2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx),
+            2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy),
+        };
+    }
+    template <class Type>
+    constexpr vector<Type, 4 * 4> vector<Type, 4 * 4>::Rotate(const quaternion& rotation)
+    {
+        return vector<Type, 3 * 3>::Rotate(rotation);
+    }
+    template <class Type>
+    constexpr vector<Type, 4 * 4> vector<Type, 4 * 4>::TRS(vector<Type, 3> position, const quaternion& rotation, vector<Type, 3> scale)
+    {
+        return ComposeTRS(position, vector<Type, 3 * 3>::Rotate(rotation), scale);
+    }
+}
@@ -0,0 +1,186 @@
+﻿#pragma once
+#include <cassert>
+#include <span>
+
+#include "MatrixMath.hpp"
+
+//批量处理大量向量的函数，内部会将数据转为按分量存放（SoA）后使用SIMD计算，每次迭代处理8个元素
+//输入和输出可以是同一块内存，输出的长度不能小于输入
+
+namespace Light
+{
+    template <bool IsPoint>
+    void TransformVectors3(const std::span<const float3> vectors, const float4x4& matrix, const std::span<float3> outVectors)
+    {
+        assert(outVectors.size() >= vectors.size() && "输出数组长度不足！");
+
+        const size_t count = vectors.size();
+        size_t i = 0;
+#if Light_Math_SSE
+        //广播矩阵元素，使一次计算可同时处理4个向量的同一分量
+        __m128 m[12];
+        for (int row = 0; row < 3; row++)
+            for (int column = 0; column < 4; column++)
+                m[row * 4 + column] = _mm_set1_ps(matrix.data[row + column * 4]);
+
+        auto transform4 = [&m](const float* source, float* destination)
+        {
+            __m128 xs, ys, zs;
+            SIMD::Deinterleave3(_mm_loadu_ps(source), _mm_loadu_ps(source + 4), _mm_loadu_ps(source + 8), xs, ys, zs);
+
+            __m128 results[3];
+            for (int row = 0; row < 3; row++)
+            {
+                const __m128* mRow = m + row * 4;
+                __m128 result = _mm_mul_ps(mRow[0], xs);
+                result = _mm_add_ps(result, _mm_mul_ps(mRow[1], ys));
+                result = _mm_add_ps(result, _mm_mul_ps(mRow[2], zs));
+                if constexpr (IsPoint)
+                    result = _mm_add_ps(result, mRow[3]);
+                results[row] = result;
+            }
+
+            __m128 a, b, c;
+            SIMD::Interleave3(results[0], results[1], results[2], a, b, c);
+            _mm_storeu_ps(destination, a);
+            _mm_storeu_ps(destination + 4, b);
+            _mm_storeu_ps(destination + 8, c);
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            transform4(vectors[i].data, outVectors[i].data);
+            transform4(vectors[i + 4].data, outVectors[i + 4].data);
+        }
+        for (; i + 4 <= count; i += 4)
+            transform4(vectors[i].data, outVectors[i].data);
+#endif
+        for (; i < count; i++)
+        {
+            const float4 result = mul(matrix, float4(vectors[i], IsPoint ? 1.0f : 0.0f));
+            outVectors[i] = {result.x, result.y, result.z};
+        }
+    }
+
+    /**
+     * 批量变换点，等价于对每个点执行 mul(matrix, float4(point, 1)).xyz
+     * @note 按仿射变换处理，不会进行透视除法
+     * @param points
+     * @param matrix
+     * @param outPoints
+     */
+    inline void TransformPoints(const std::span<const float3> points, const float4x4& matrix, const std::span<float3> outPoints)
+    {
+        TransformVectors3<true>(points, matrix, outPoints);
+    }
+    /**
+     * 批量变换方向，等价于对每个方向执行 mul(matrix, float4(direction, 0)).xyz ，即不受平移影响
+     * @param directions
+     * @param matrix
+     * @param outDirections
+     */
+    inline void TransformDirections(const std::span<const float3> directions, const float4x4& matrix, const std::span<float3> outDirections)
+    {
+        TransformVectors3<false>(directions, matrix, outDirections);
+    }
+
+    /**
+     * 批量归一化，等价于对每个向量执行 normalize(vector)
+     * @param vectors
+     * @param outVectors
+     */
+    inline void NormalizeAll(const std::span<const float3> vectors, const std::span<float3> outVectors)
+    {
+        assert(outVectors.size() >= vectors.size() && "输出数组长度不足！");
+
+        const size_t count = vectors.size();
+        size_t i = 0;
+#if Light_Math_SSE
+        auto normalize4 = [](const float* source, float* destination)
+        {
+            __m128 xs, ys, zs;
+            SIMD::Deinterleave3(_mm_loadu_ps(source), _mm_loadu_ps(source + 4), _mm_loadu_ps(source + 8), xs, ys, zs);
+
+            __m128 lengths = _mm_mul_ps(xs, xs);
+            lengths = _mm_add_ps(lengths, _mm_mul_ps(ys, ys));
+            lengths = _mm_add_ps(lengths, _mm_mul_ps(zs, zs));
+            lengths = _mm_sqrt_ps(lengths);
+
+            __m128 a, b, c;
+            SIMD::Interleave3(_mm_div_ps(xs, lengths), _mm_div_ps(ys, lengths), _mm_div_ps(zs, lengths), a, b, c);
+            _mm_storeu_ps(destination, a);
+            _mm_storeu_ps(destination + 4, b);
+            _mm_storeu_ps(destination + 8, c);
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            normalize4(vectors[i].data, outVectors[i].data);
+            normalize4(vectors[i + 4].data, outVectors[i + 4].data);
+        }
+        for (; i + 4 <= count; i += 4)
+            normalize4(vectors[i].data, outVectors[i].data);
+#endif
+        for (; i < count; i++)
+            outVectors[i] = normalize(vectors[i]);
+    }
+
+    /**
+     * 将紧凑存放的三维向量（AoS）拆分为按分量存放（SoA）的三个数组
+     * @param vectors
+     * @param xs
+     * @param ys
+     * @param zs
+     */
+    inline void AoSToSoA(const std::span<const float3> vectors, const std::span<float> xs, const std::span<float> ys, const std::span<float> zs)
+    {
+        assert(xs.size() >= vectors.size() && ys.size() >= vectors.size() && zs.size() >= vectors.size() && "输出数组长度不足！");
+
+        const size_t count = vectors.size();
+        size_t i = 0;
+#if Light_Math_SSE
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* source = vectors[i].data;
+            __m128 x, y, z;
+            SIMD::Deinterleave3(_mm_loadu_ps(source), _mm_loadu_ps(source + 4), _mm_loadu_ps(source + 8), x, y, z);
+            _mm_storeu_ps(xs.data() + i, x);
+            _mm_storeu_ps(ys.data() + i, y);
+            _mm_storeu_ps(zs.data() + i, z);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            xs[i] = vectors[i].x;
+            ys[i] = vectors[i].y;
+            zs[i] = vectors[i].z;
+        }
+    }
+    /**
+     * AoSToSoA的逆操作
+     * @param xs
+     * @param ys
+     * @param zs
+     * @param vectors 长度决定了转换的数量
+     */
+    inline void SoAToAoS(const std::span<const float> xs, const std::span<const float> ys, const std::span<const float> zs, const std::span<float3> vectors)
+    {
+        assert(xs.size() >= vectors.size() && ys.size() >= vectors.size() && zs.size() >= vectors.size() && "输入数组长度不足！");
+
+        const size_t count = vectors.size();
+        size_t i = 0;
+#if Light_Math_SSE
+        for (; i + 4 <= count; i += 4)
+        {
+            float* destination = vectors[i].data;
+            __m128 a, b, c;
+            SIMD::Interleave3(_mm_loadu_ps(xs.data() + i), _mm_loadu_ps(ys.data() + i), _mm_loadu_ps(zs.data() + i), a, b, c);
+            _mm_storeu_ps(destination, a);
+            _mm_storeu_ps(destination + 4, b);
+            _mm_storeu_ps(destination + 8, c);
+        }
+#endif
+        for (; i < count; i++)
+            vectors[i] = {xs[i], ys[i], zs[i]};
+    }
+}
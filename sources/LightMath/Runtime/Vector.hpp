@@ -113,6 +113,7 @@ namespace Light
         Light_MakeVectorMemberFunctions_Indexer(Type)
     };
 
+    //保持分量类型的自然对齐，SIMD实现使用非对齐加载，因此包含四维向量的顶点、组件等结构不会因此产生填充
     template <class Type>
     struct vector<Type, 4>
     {
@@ -1,10 +1,12 @@
-#pragma once
+﻿#pragma once
 #include <algorithm>
 #include <cmath>
 #include <format>
+#include <type_traits>
 
 #include "Math.hpp"
 #include "Vector.hpp"
+#include "VectorSIMD.hpp"
 
 //模板没法触发自动类型转换，且有候选优先级较低的问题，因此只能利用宏来大批量定义函数
 //VV1V：表示两个向量参与计算，并将结果存在第一个向量后返回
@@ -189,12 +191,14 @@ constexpr vector<Type, Number> project(const vector<Type, Number>& v, const vect
     return n * dot(v, n);\
 }
 
-#define Light_MakeVectorFunctions_Integer(Type,Number)\
+#define Light_MakeVectorFunctions_Increment(Type,Number)\
 Light_MakeVectorFunction_SymbolV1V(++, Type, Number);\
 Light_MakeVectorFunction_SymbolV1V(--, Type, Number);\
 Light_MakeVectorFunction_SymbolV1VSuf(++, Type, Number);\
 Light_MakeVectorFunction_SymbolV1VSuf(--, Type, Number);\
-Light_MakeVectorFunction_SymbolV2V(-, Type, Number);\
+Light_MakeVectorFunction_SymbolV2V(-, Type, Number);
+
+#define Light_MakeVectorFunctions_Arithmetic(Type,Number)\
 Light_MakeVectorFunction_SymbolVV1V(+=, Type, Number);\
 Light_MakeVectorFunction_SymbolVV1V(-=, Type, Number);\
 Light_MakeVectorFunction_SymbolVV1V(*=, Type, Number);\
@@ -204,8 +208,11 @@ Light_MakeVectorFunction_SymbolVV2V(-, Type, Number);\
 Light_MakeVectorFunction_SymbolVV2V(*, Type, Number);\
 Light_MakeVectorFunction_SymbolVV2V(/, Type, Number);
 
-#define Light_MakeVectorFunctions_Decimals(Type,Number)\
-Light_MakeVectorFunctions_Integer(Type,Number)\
+#define Light_MakeVectorFunctions_Integer(Type,Number)\
+Light_MakeVectorFunctions_Increment(Type,Number)\
+Light_MakeVectorFunctions_Arithmetic(Type,Number)
+
+#define Light_MakeVectorFunctions_Elementwise(Type,Number)\
 Light_MakeVectorFunction_FunctionV2V(cos, Type, Number, );\
 Light_MakeVectorFunction_FunctionV2V(acos, Type, Number, );\
 Light_MakeVectorFunction_FunctionV2V(sin, Type, Number, );\
@@ -223,12 +230,19 @@ Light_MakeVectorFunction_FunctionV2V(ceil, Type, Number, );\
 Light_MakeVectorFunction_FunctionV2V(floor, Type, Number, );\
 Light_MakeVectorFunction_FunctionVV2V(fmod, Type, Number);\
 Light_MakeVectorFunction_FunctionVV2V(pow, Type, Number);\
-Light_MakeVectorFunction_FunctionVV2V(max, Type, Number);\
-Light_MakeVectorFunction_FunctionVV2V(min, Type, Number);\
 Light_MakeVectorFunction_FunctionVVV2V(clamp, Type, Number);\
 Light_MakeVectorFunction_Equal(Type, Number);\
 Light_MakeVectorFunction_All(Type, Number);\
-Light_MakeVectorFunction_Any(Type, Number);\
+Light_MakeVectorFunction_Any(Type, Number);
+
+#define Light_MakeVectorFunctions_MinMax(Type,Number)\
+Light_MakeVectorFunction_FunctionVV2V(max, Type, Number);\
+Light_MakeVectorFunction_FunctionVV2V(min, Type, Number);
+
+#define Light_MakeVectorFunctions_Decimals(Type,Number)\
+Light_MakeVectorFunctions_Integer(Type,Number)\
+Light_MakeVectorFunctions_Elementwise(Type,Number)\
+Light_MakeVectorFunctions_MinMax(Type,Number)\
 Light_MakeVectorFunction_Dot(Type, Number);\
 Light_MakeVectorFunction_Length(Type, Number);\
 Light_MakeVectorFunction_Normalize(Type, Number);\
@@ -237,6 +251,119 @@ Light_MakeVectorFunction_Lerp(Type, Number);\
 Light_MakeVectorFunction_Angle(Type, Number);\
 Light_MakeVectorFunction_Project(Type, Number);
 
+#if Light_Math_SSE
+    //以下为基于SSE的float向量函数，每次处理4个分量，因此也适用于由多个四维向量组成的矩阵
+    //三维向量仅在寄存器中补齐第四个分量，内存中依然是紧凑的12字节
+    //常量求值时无法使用SIMD指令，此时退回到标量实现
+
+#define Light_MakeVectorFunction_SymbolVV2VSIMD(Symbol,Intrinsic,Number)\
+constexpr vector<float, Number> operator Symbol(const vector<float, Number>& a, const vector<float, Number>& b)\
+{\
+    vector<float, Number> result;\
+    if (std::is_constant_evaluated())\
+    {\
+        for (int i = 0; i < (Number); i++)\
+            result.data[i] = a.data[i] Symbol b.data[i];\
+    }\
+    else\
+    {\
+        for (int i = 0; i < (Number); i += 4)\
+            SIMD::Store<Number>(result.data + i, Intrinsic(SIMD::Load<Number>(a.data + i), SIMD::Load<Number>(b.data + i)));\
+    }\
+    return result;\
+}
+
+#define Light_MakeVectorFunction_SymbolVV1VSIMD(AssignSymbol,Symbol,Number)\
+constexpr vector<float, Number>& operator AssignSymbol(vector<float, Number>& a, const vector<float, Number>& b)\
+{\
+    a = a Symbol b;\
+    return a;\
+}
+
+    /**
+     * 逐分量取最值
+     * @note 参数顺序与std::min/std::max保持一致，使得在存在NaN或正负零时结果与标量实现相同
+     */
+#define Light_MakeVectorFunction_FunctionVV2VSIMD(Function,Intrinsic,Number)\
+constexpr vector<float, Number> Function(const vector<float, Number>& a, const vector<float, Number>& b)\
+{\
+    vector<float, Number> result;\
+    if (std::is_constant_evaluated())\
+    {\
+        for (int i = 0; i < (Number); i++)\
+            result.data[i] = std::Function(a.data[i], b.data[i]);\
+    }\
+    else\
+    {\
+        for (int i = 0; i < (Number); i += 4)\
+            SIMD::Store<Number>(result.data + i, Intrinsic(SIMD::Load<Number>(b.data + i), SIMD::Load<Number>(a.data + i)));\
+    }\
+    return result;\
+}
+
+#define Light_MakeVectorFunction_DotSIMD(Number)\
+constexpr float dot(const vector<float, Number>& a, const vector<float, Number>& b)\
+{\
+    if (std::is_constant_evaluated())\
+    {\
+        float result = 0;\
+        for (int i = 0; i < (Number); i++)\
+            result += a.data[i] * b.data[i];\
+        return result;\
+    }\
+    __m128 sum = _mm_setzero_ps();\
+    for (int i = 0; i < (Number); i += 4)\
+        sum = _mm_add_ps(sum, _mm_mul_ps(SIMD::Load<Number>(a.data + i), SIMD::Load<Number>(b.data + i)));\
+    return _mm_cvtss_f32(SIMD::HorizontalAdd(sum));\
+}
+
+#define Light_MakeVectorFunction_NormalizeSIMD(Number)\
+inline vector<float, Number> normalize(const vector<float, Number>& a)\
+{\
+    const __m128 lengths = _mm_set1_ps(length(a));\
+    vector<float, Number> result;\
+    for (int i = 0; i < (Number); i += 4)\
+        SIMD::Store<Number>(result.data + i, _mm_div_ps(SIMD::Load<Number>(a.data + i), lengths));\
+    return result;\
+}
+
+#define Light_MakeVectorFunction_LerpSIMD(Number)\
+constexpr vector<float, Number> lerp(const vector<float, Number>& origin, const vector<float, Number>& destination, const float rate)\
+{\
+    if (std::is_constant_evaluated())\
+        return origin + rate * (destination - origin);\
+    const __m128 rates = _mm_set1_ps(rate);\
+    vector<float, Number> result;\
+    for (int i = 0; i < (Number); i += 4)\
+    {\
+        const __m128 o = SIMD::Load<Number>(origin.data + i);\
+        const __m128 d = SIMD::Load<Number>(destination.data + i);\
+        SIMD::Store<Number>(result.data + i, _mm_add_ps(o, _mm_mul_ps(rates, _mm_sub_ps(d, o))));\
+    }\
+    return result;\
+}
+
+#define Light_MakeVectorFunctions_DecimalsSIMD(Number)\
+Light_MakeVectorFunctions_Increment(float, Number)\
+Light_MakeVectorFunction_SymbolVV2VSIMD(+, _mm_add_ps, Number);\
+Light_MakeVectorFunction_SymbolVV2VSIMD(-, _mm_sub_ps, Number);\
+Light_MakeVectorFunction_SymbolVV2VSIMD(*, _mm_mul_ps, Number);\
+Light_MakeVectorFunction_SymbolVV2VSIMD(/, _mm_div_ps, Number);\
+Light_MakeVectorFunction_SymbolVV1VSIMD(+=, +, Number);\
+Light_MakeVectorFunction_SymbolVV1VSIMD(-=, -, Number);\
+Light_MakeVectorFunction_SymbolVV1VSIMD(*=, *, Number);\
+Light_MakeVectorFunction_SymbolVV1VSIMD(/=, /, Number);\
+Light_MakeVectorFunctions_Elementwise(float, Number)\
+Light_MakeVectorFunction_FunctionVV2VSIMD(max, _mm_max_ps, Number);\
+Light_MakeVectorFunction_FunctionVV2VSIMD(min, _mm_min_ps, Number);\
+Light_MakeVectorFunction_DotSIMD(Number);\
+Light_MakeVectorFunction_Length(float, Number);\
+Light_MakeVectorFunction_NormalizeSIMD(Number);\
+Light_MakeVectorFunction_Distance(float, Number);\
+Light_MakeVectorFunction_LerpSIMD(Number);\
+Light_MakeVectorFunction_Angle(float, Number);\
+Light_MakeVectorFunction_Project(float, Number);
+#endif
 
     /**
      * 三维向量叉乘
@@ -284,8 +411,13 @@ return str + ")";\
 }
     
     Light_MakeVectorFunctions_Decimals(float, 2)
+#if Light_Math_SSE
+    Light_MakeVectorFunctions_DecimalsSIMD(3)
+    Light_MakeVectorFunctions_DecimalsSIMD(4)
+#else
     Light_MakeVectorFunctions_Decimals(float, 3)
     Light_MakeVectorFunctions_Decimals(float, 4)
+#endif
     Light_MakeVectorFunctions_Vector3Extra(float)
     Light_MakeVectorFunction_ToString(float, 2, ":f")
     Light_MakeVectorFunction_ToString(float, 3, ":f")
@@ -0,0 +1,114 @@
+﻿#pragma once
+
+//检测可用的SIMD指令集，可通过定义Light_Math_DisableSIMD来强制使用标量实现
+#if !defined(Light_Math_DisableSIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define Light_Math_SSE 1
+#include <immintrin.h>
+#else
+#define Light_Math_SSE 0
+#endif
+
+//F16C指令集用于半精度浮点数的批量转换，MSVC没有单独的宏，但启用AVX2时必然可用
+#if Light_Math_SSE && (defined(__F16C__) || defined(__AVX2__))
+#define Light_Math_F16C 1
+#else
+#define Light_Math_F16C 0
+#endif
+
+#if Light_Math_SSE
+namespace Light::SIMD
+{
+    /**
+     * 加载4个连续的float到寄存器
+     *
+     * 三维向量不存在第四个分量，此时仅加载三个分量并将第四通道置零，从而在不改变float3内存布局（顶点格式等依赖其12字节大小）的情况下使用SIMD计算。
+     * @tparam Number 向量维度，需为3或4的倍数
+     * @param data
+     * @return
+     */
+    template <int Number>
+    __m128 Load(const float* data)
+    {
+        if constexpr (Number == 3)
+        {
+            const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(data)));
+            const __m128 z = _mm_load_ss(data + 2);
+            return _mm_movelh_ps(xy, z);
+        }
+        else
+        {
+            return _mm_loadu_ps(data);
+        }
+    }
+    template <int Number>
+    void Store(float* data, const __m128 value)
+    {
+        if constexpr (Number == 3)
+        {
+            _mm_store_sd(reinterpret_cast<double*>(data), _mm_castps_pd(value));
+            _mm_store_ss(data + 2, _mm_movehl_ps(value, value));
+        }
+        else
+        {
+            _mm_storeu_ps(data, value);
+        }
+    }
+
+    /**
+     * 水平求和，结果广播至所有通道
+     * @param value
+     * @return
+     */
+    inline __m128 HorizontalAdd(const __m128 value)
+    {
+        __m128 shuffle = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)); //(y,x,w,z)
+        __m128 sum = _mm_add_ps(value, shuffle); //(x+y,x+y,z+w,z+w)
+        shuffle = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)); //(z+w,z+w,x+y,x+y)
+        return _mm_add_ps(sum, shuffle);
+    }
+    inline __m128 Dot(const __m128 a, const __m128 b)
+    {
+        return HorizontalAdd(_mm_mul_ps(a, b));
+    }
+
+    /**
+     * 计算按列存储的4x4矩阵与一列向量的乘积
+     * @param columns 矩阵的四列
+     * @param vector
+     * @return
+     */
+    inline __m128 MulColumn(const __m128 columns[4], const __m128 vector)
+    {
+        __m128 result = _mm_mul_ps(columns[0], _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm_add_ps(result, _mm_mul_ps(columns[3], _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3))));
+        return result;
+    }
+
+    /**
+     * 将4个紧凑存放的三维向量（AoS）转为按分量存放（SoA）
+     * @param a (x0,y0,z0,x1)
+     * @param b (y1,z1,x2,y2)
+     * @param c (z2,x3,y3,z3)
+     * @param xs 输出(x0,x1,x2,x3)
+     * @param ys 输出(y0,y1,y2,y3)
+     * @param zs 输出(z0,z1,z2,z3)
+     */
+    inline void Deinterleave3(const __m128 a, const __m128 b, const __m128 c, __m128& xs, __m128& ys, __m128& zs)
+    {
+        xs = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 0, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        ys = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        zs = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+    /**
+     * Deinterleave3的逆操作
+     */
+    inline void Interleave3(const __m128 xs, const __m128 ys, const __m128 zs, __m128& a, __m128& b, __m128& c)
+    {
+        a = _mm_shuffle_ps(_mm_shuffle_ps(xs, ys, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(zs, xs, _MM_SHUFFLE(0, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        b = _mm_shuffle_ps(_mm_shuffle_ps(ys, zs, _MM_SHUFFLE(0, 1, 0, 1)), _mm_shuffle_ps(xs, ys, _MM_SHUFFLE(0, 2, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        c = _mm_shuffle_ps(_mm_shuffle_ps(zs, xs, _MM_SHUFFLE(0, 3, 0, 2)), _mm_shuffle_ps(ys, zs, _MM_SHUFFLE(0, 3, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+}
+#endif
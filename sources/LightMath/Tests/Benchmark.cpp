@@ -0,0 +1,455 @@
+﻿#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <benchmark/benchmark.h>
+#include "LightMath/Runtime/MatrixMath.hpp"
+#include "LightMath/Runtime/StreamMath.hpp"
+#include "LightMath/Runtime/Geometry.hpp"
+#include "LightMath/Runtime/PackedVector.hpp"
+
+using namespace Light;
+
+//作为对照的朴素结构体，不含联合体和Swizzle成员，用于观察Swizzle对代码生成的影响
+struct PlainFloat3
+{
+    float x, y, z;
+};
+
+constexpr int ArraySize = 4096;
+
+template <class T>
+std::vector<T> MakeRandomArray(const int count)
+{
+    std::mt19937 random(0); // NOLINT(cert-msc51-cpp)
+    std::uniform_real_distribution distribution(-10.0f, 10.0f);
+    std::vector<T> array(count);
+    for (T& item : array)
+        for (float& value : item.data)
+            value = distribution(random);
+    return array;
+}
+
+void RegisterVectorBenchmarks()
+{
+    benchmark::RegisterBenchmark("Vector/Float4Add/Scalar", [](benchmark::State& state)
+    {
+        std::vector<float4> a = MakeRandomArray<float4>(ArraySize);
+        std::vector<float4> b = MakeRandomArray<float4>(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+                for (int j = 0; j < 4; j++)
+                    a[i].data[j] = a[i].data[j] + b[i].data[j];
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float4Add/Vector", [](benchmark::State& state)
+    {
+        std::vector<float4> a = MakeRandomArray<float4>(ArraySize);
+        std::vector<float4> b = MakeRandomArray<float4>(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+                a[i] += b[i];
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Dot/Single", [](benchmark::State& state)
+    {
+        float3 a = {1, 2, 3};
+        float3 b = {4, 5, 6};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(dot(a, b));
+        }
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Dot/Scalar", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> b = MakeRandomArray<float3>(ArraySize);
+        for (auto _ : state)
+        {
+            float sum = 0;
+            for (int i = 0; i < ArraySize; i++)
+                sum += a[i].data[0] * b[i].data[0] + a[i].data[1] * b[i].data[1] + a[i].data[2] * b[i].data[2];
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Dot/Array", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> b = MakeRandomArray<float3>(ArraySize);
+        for (auto _ : state)
+        {
+            float sum = 0;
+            for (int i = 0; i < ArraySize; i++)
+                sum += dot(a[i], b[i]);
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Normalize/Single", [](benchmark::State& state)
+    {
+        float3 a = {1, 2, 3};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(normalize(a));
+        }
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Normalize/Scalar", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> result(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+            {
+                const float* v = a[i].data;
+                float inverseLength = 1 / std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                for (int j = 0; j < 3; j++)
+                    result[i].data[j] = v[j] * inverseLength;
+            }
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Normalize/Array", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> result(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+                result[i] = normalize(a[i]);
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Vector/Float3Normalize/Stream", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> result(ArraySize);
+        for (auto _ : state)
+        {
+            NormalizeAll(a, result);
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+}
+
+void RegisterSwizzleBenchmarks()
+{
+    //同样的计算分别通过朴素结构体、分量成员和Swizzle成员实现
+    benchmark::RegisterBenchmark("Swizzle/Plain", [](benchmark::State& state)
+    {
+        std::vector<float3> source = MakeRandomArray<float3>(ArraySize);
+        std::vector<PlainFloat3> a(ArraySize);
+        std::memcpy(a.data(), source.data(), sizeof(float3) * ArraySize);
+        for (auto _ : state)
+        {
+            for (PlainFloat3& v : a)
+                v = {v.z * 2 + v.y, v.y * 2 + v.x, v.x * 2 + v.z};
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Swizzle/Component", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        for (auto _ : state)
+        {
+            for (float3& v : a)
+                v = {v.z * 2 + v.y, v.y * 2 + v.x, v.x * 2 + v.z};
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Swizzle/Swizzle", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        for (auto _ : state)
+        {
+            for (float3& v : a)
+                v = v.zyx * 2 + v.yxz;
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Swizzle/SwizzleAssign", [](benchmark::State& state)
+    {
+        std::vector<float3> a = MakeRandomArray<float3>(ArraySize);
+        for (auto _ : state)
+        {
+            for (float3& v : a)
+                v.zyx = v.xyz * 2 + v.zxy;
+            benchmark::DoNotOptimize(a.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+}
+
+void RegisterMatrixBenchmarks()
+{
+    benchmark::RegisterBenchmark("Matrix/Mul3x3", [](benchmark::State& state)
+    {
+        float3x3 a = float3x3::Rotate({30, 60, 90});
+        float3x3 b = float3x3::Scale({1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(mul(a, b));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Mul3x3/Array", [](benchmark::State& state)
+    {
+        std::vector<float3x3> a = MakeRandomArray<float3x3>(ArraySize);
+        float3x3 rotation = float3x3::Rotate({30, 60, 90});
+        std::vector<float3x3> result(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+                result[i] = mul(rotation, a[i]);
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Matrix/Mul4x4/Scalar", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        float4x4 b = float4x4::Perspective(60, 16.0f / 9.0f, 0.3f, 1000.0f);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(mul<float>(a, b));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Mul4x4/Vector", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        float4x4 b = float4x4::Perspective(60, 16.0f / 9.0f, 0.3f, 1000.0f);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(mul(a, b));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Mul4x4/Array", [](benchmark::State& state)
+    {
+        std::vector<float4x4> a = MakeRandomArray<float4x4>(ArraySize);
+        float4x4 viewProjection = float4x4::Perspective(60, 16.0f / 9.0f, 0.3f, 1000.0f);
+        std::vector<float4x4> result(ArraySize);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+                result[i] = mul(viewProjection, a[i]);
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Matrix/TransformPoints/Scalar", [](benchmark::State& state)
+    {
+        std::vector<float3> points = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> result(ArraySize);
+        float4x4 matrix = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            for (int i = 0; i < ArraySize; i++)
+            {
+                float4 point = mul<float>(matrix, float4(points[i], 1));
+                result[i] = {point.x, point.y, point.z};
+            }
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Matrix/TransformPoints/Stream", [](benchmark::State& state)
+    {
+        std::vector<float3> points = MakeRandomArray<float3>(ArraySize);
+        std::vector<float3> result(ArraySize);
+        float4x4 matrix = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            TransformPoints(points, matrix, result);
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ArraySize);
+    });
+    benchmark::RegisterBenchmark("Matrix/Determinant4x4/Cofactor", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            float result = 0;
+            for (int column = 0; column < 4; column++)
+                result += a.data[column * 4] * cofactor_determinant(a, 0, column);
+            benchmark::DoNotOptimize(result);
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Determinant4x4", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(determinant(a));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Inverse4x4/Adjoint", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(adjoint(a) / determinant(a));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Inverse4x4", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(inverse(a));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Inverse4x4/Affine", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(inverse_affine(a));
+        }
+    });
+    benchmark::RegisterBenchmark("Matrix/Inverse4x4/Rigid", [](benchmark::State& state)
+    {
+        float4x4 a = float4x4::TRS({1, 2, 3}, {30, 60, 90}, 1);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(inverse_rigid(a));
+        }
+    });
+}
+
+void RegisterGeometryBenchmarks()
+{
+    constexpr int ObjectCount = 100000;
+    auto makeBoxes = []
+    {
+        std::vector<float3> centers = MakeRandomArray<float3>(ObjectCount);
+        std::vector<AABB> boxes(ObjectCount);
+        for (int i = 0; i < ObjectCount; i++)
+            boxes[i] = AABB::FromCenterExtents(centers[i] * 10.0f, 1);
+        return boxes;
+    };
+
+    benchmark::RegisterBenchmark("Geometry/CullAABBs/Scalar", [makeBoxes](benchmark::State& state)
+    {
+        std::vector<AABB> boxes = makeBoxes();
+        std::vector<uint32_t> masks((ObjectCount + 31) / 32);
+        Frustum frustum = Frustum::FromMatrix(float4x4::Perspective(60, 16.0f / 9.0f, 0.3f, 1000.0f));
+        for (auto _ : state)
+        {
+            std::ranges::fill(masks, 0);
+            for (int i = 0; i < ObjectCount; i++)
+                if (frustum.Intersects(boxes[i]))
+                    masks[i / 32] |= 1u << (i % 32);
+            benchmark::DoNotOptimize(masks.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ObjectCount);
+    });
+    benchmark::RegisterBenchmark("Geometry/CullAABBs/Batch", [makeBoxes](benchmark::State& state)
+    {
+        std::vector<AABB> boxes = makeBoxes();
+        std::vector<uint32_t> masks((ObjectCount + 31) / 32);
+        Frustum frustum = Frustum::FromMatrix(float4x4::Perspective(60, 16.0f / 9.0f, 0.3f, 1000.0f));
+        for (auto _ : state)
+        {
+            CullAABBs(frustum, boxes, masks);
+            benchmark::DoNotOptimize(masks.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ObjectCount);
+    });
+}
+
+void RegisterPackedBenchmarks()
+{
+    //以顶点数据为参照，float4数组转为半精度的耗时
+    std::vector<float4> source = MakeRandomArray<float4>(ArraySize);
+
+    benchmark::RegisterBenchmark("Packed/PackHalfs/Scalar", [source](benchmark::State& state)
+    {
+        std::span<const float> values = {source[0].data, source.size() * 4};
+        std::vector<half> halfs(values.size());
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < values.size(); i++)
+                halfs[i] = half(values[i]);
+            benchmark::DoNotOptimize(halfs.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * values.size());
+    });
+    benchmark::RegisterBenchmark("Packed/PackHalfs/Batch", [source](benchmark::State& state)
+    {
+        std::span<const float> values = {source[0].data, source.size() * 4};
+        std::vector<half> halfs(values.size());
+        for (auto _ : state)
+        {
+            PackHalfs(values, halfs);
+            benchmark::DoNotOptimize(halfs.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * values.size());
+    });
+    benchmark::RegisterBenchmark("Packed/UnpackHalfs/Batch", [source](benchmark::State& state)
+    {
+        std::span<const float> values = {source[0].data, source.size() * 4};
+        std::vector<half> halfs(values.size());
+        PackHalfs(values, halfs);
+        std::vector<float> floats(values.size());
+        for (auto _ : state)
+        {
+            UnpackHalfs(halfs, floats);
+            benchmark::DoNotOptimize(floats.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * values.size());
+    });
+}
+
+TEST(Math, Benchmark)
+{
+    RegisterVectorBenchmarks();
+    RegisterSwizzleBenchmarks();
+    RegisterMatrixBenchmarks();
+    RegisterGeometryBenchmarks();
+    RegisterPackedBenchmarks();
+    benchmark::Initialize(nullptr, nullptr);
+    benchmark::RunSpecifiedBenchmarks();
+}
@@ -1,6 +1,10 @@
 ﻿#include <gtest/gtest.h>
 #include "LightMath/Runtime/VectorMath.hpp"
 #include "LightMath/Runtime/MatrixMath.hpp"
+#include "LightMath/Runtime/StreamMath.hpp"
+#include "LightMath/Runtime/Quaternion.hpp"
+#include "LightMath/Runtime/Geometry.hpp"
+#include "LightMath/Runtime/PackedVector.hpp"
 
 /// 验证工具：https://www.math666.com/
 
@@ -98,6 +102,66 @@ TEST(Math, MatrixMath)
 |0.350000 -0.025000 -0.050000 -0.025000|)");
 }
 
+TEST(Math, MatrixInverse)
+{
+    float4x4 matrices[] = {
+        {
+            2, 1, 1, 4,
+            5, 5, 7, 7,
+            7, 1, 3, 1,
+            9, 7, 1, 7
+        },
+        {
+            0.5f, -3, 2, 1,
+            4, 0.25f, -1, 6,
+            -2, 8, 3, -0.75f,
+            1, 2, -5, 9
+        },
+        float4x4::TRS({1, -2, 3}, {30, 60, 90}, {2, 0.5f, 3}),
+        float4x4::Perspective(60.0f, 16.0f / 9.0f, 0.3f, 1000.0f),
+    };
+
+    //与基于余子式的实现对比
+    for (const float4x4& matrix : matrices)
+    {
+        float cofactorDeterminant = 0;
+        for (int column = 0; column < 4; column++)
+            cofactorDeterminant += matrix.data[column * 4] * cofactor_determinant(matrix, 0, column);
+        ASSERT_NEAR(determinant(matrix), cofactorDeterminant, abs(cofactorDeterminant) * 1e-5f);
+
+        float4x4 inverseM = inverse(matrix);
+        float4x4 adjointInverseM = adjoint(matrix) / cofactorDeterminant;
+        for (int i = 0; i < 16; i++)
+            ASSERT_NEAR(inverseM.data[i], adjointInverseM.data[i], 1e-4f);
+    }
+
+    //仿射矩阵
+    float4x4 trs = float4x4::TRS({1, -2, 3}, {30, 60, 90}, {2, 0.5f, 3});
+    float4x4 inverseAffine = inverse_affine(trs);
+    float4x4 inverseGeneral = inverse(trs);
+    for (int i = 0; i < 16; i++)
+        ASSERT_NEAR(inverseAffine.data[i], inverseGeneral.data[i], 1e-5f);
+
+    //刚体变换矩阵
+    float4x4 view = float4x4::TRS({2, 2, 2}, {32, -135, 0}, 1);
+    float4x4 inverseRigid = inverse_rigid(view);
+    inverseGeneral = inverse(view);
+    for (int i = 0; i < 16; i++)
+        ASSERT_NEAR(inverseRigid.data[i], inverseGeneral.data[i], 1e-5f);
+    float4 origin = mul(inverseRigid, float4(2, 2, 2, 1));
+    for (int i = 0; i < 4; i++)
+        ASSERT_NEAR(origin.data[i], float4(0, 0, 0, 1).data[i], 1e-5f);
+
+    float3x3 matrix3 = {
+        2, 1, 4,
+        7, 1, 1,
+        9, 7, 7
+    };
+    ASSERT_EQ(to_string(mul(matrix3, inverse(matrix3))), R"(|1.000000 0.000000 0.000000|
+|0.000000 1.000000 0.000000|
+|0.000000 0.000000 1.000000|)");
+}
+
 TEST(Math, TRSMatrix)
 {
     ASSERT_TRUE(all(float4x4::Scale({1,2,3}) ==float4x4(
@@ -129,6 +193,47 @@ TEST(Math, TRSMatrix)
     ASSERT_TRUE(all(mul(matrix,float4(0, 0, 0, 1)) == float4(-2,-2,2,1)));
 }
 
+TEST(Math, Quaternion)
+{
+    auto assertNear = [](const float* a, const float* b, const int count, const float error = 1e-5f)
+    {
+        for (int i = 0; i < count; i++)
+            ASSERT_NEAR(a[i], b[i], error);
+    };
+
+    float3 eulers[] = {{30, 60, 90}, {-45, 120, 10}, {80, -170, -35}, {0, 0, 0}};
+    for (const float3& degree : eulers)
+    {
+        //与欧拉角矩阵互相转换
+        quaternion q = quaternion::Euler(degree);
+        float3x3 rotation = float3x3::Rotate(degree);
+        assertNear(float3x3::Rotate(q).data, rotation.data, 9);
+        quaternion fromMatrix = quaternion(rotation);
+        ASSERT_NEAR(abs(dot(fromMatrix, q)), 1, 1e-5f);
+        assertNear(euler(q).data, degree.data, 3, 1e-3f);
+
+        //旋转向量及构建变换矩阵
+        float3 v = {1, -2, 3};
+        float4 rotated = mul(float4x4::Rotate(degree), float4(v, 0));
+        assertNear(mul(q, v).data, rotated.data, 3);
+        assertNear(float4x4::TRS({1, 2, 3}, q, {2, 0.5f, 3}).data, float4x4::TRS({1, 2, 3}, degree, {2, 0.5f, 3}).data, 16);
+    }
+
+    quaternion identity = quaternion::Identity();
+    quaternion rotateY = quaternion::AxisAngle({0, 1, 0}, 90);
+    assertNear(mul(rotateY, float3(1, 0, 0)).data, float3(0, 0, -1).data, 3);
+    assertNear(mul(rotateY, conjugate(rotateY)).value.data, identity.value.data, 4);
+    assertNear(mul(quaternion::AxisAngle({0, 1, 0}, 30), quaternion::AxisAngle({0, 1, 0}, 60)).value.data, rotateY.value.data, 4);
+
+    //插值
+    quaternion half = quaternion::AxisAngle({0, 1, 0}, 45);
+    assertNear(slerp(identity, rotateY, 0).value.data, identity.value.data, 4);
+    assertNear(slerp(identity, rotateY, 1).value.data, rotateY.value.data, 4);
+    assertNear(slerp(identity, rotateY, 0.5f).value.data, half.value.data, 4);
+    assertNear(nlerp(identity, rotateY, 0.5f).value.data, half.value.data, 4);
+    assertNear(slerp(identity, quaternion(-rotateY.value), 0.5f).value.data, half.value.data, 4);
+}
+
 TEST(Math, ProjectMatrix)
 {
     ASSERT_EQ(to_string(float4x4::Ortho(8,5,0.3f,1000.0f)), R"(|0.125000 0.000000 0.000000 0.000000|
@@ -141,3 +246,151 @@ TEST(Math, ProjectMatrix)
 |0.000000 0.000000 1.000300 -0.300090|
 |0.000000 0.000000 1.000000 0.000000|)");
 }
+
+TEST(Math, StreamMath)
+{
+    //19个元素可覆盖每次8个、每次4个以及逐个处理的情况
+    std::vector<float3> vectors(19);
+    for (int i = 0; i < 19; i++)
+        vectors[i] = float3(static_cast<float>(i), static_cast<float>(i % 5) - 2, 1 - static_cast<float>(i) * 0.5f);
+    float4x4 matrix = float4x4::TRS({1, 2, 3}, {30, 60, 90}, {1, 2, 3});
+
+    std::vector<float3> points(19);
+    TransformPoints(vectors, matrix, points);
+    std::vector<float3> directions(19);
+    TransformDirections(vectors, matrix, directions);
+    std::vector<float3> normals(19);
+    NormalizeAll(vectors, normals);
+    for (int i = 0; i < 19; i++)
+    {
+        ASSERT_TRUE(all(float4(points[i], 1) == mul(matrix, float4(vectors[i], 1))));
+        ASSERT_TRUE(all(float4(directions[i], 0) == mul(matrix, float4(vectors[i], 0))));
+        ASSERT_TRUE(all(normals[i] == normalize(vectors[i])));
+    }
+
+    std::vector<float> xs(19), ys(19), zs(19);
+    AoSToSoA(vectors, xs, ys, zs);
+    for (int i = 0; i < 19; i++)
+        ASSERT_TRUE(all(float3(xs[i], ys[i], zs[i]) == vectors[i]));
+    std::vector<float3> result(19);
+    SoAToAoS(xs, ys, zs, result);
+    for (int i = 0; i < 19; i++)
+        ASSERT_TRUE(all(result[i] == vectors[i]));
+
+    //支持原地计算
+    TransformPoints(vectors, matrix, vectors);
+    for (int i = 0; i < 19; i++)
+        ASSERT_TRUE(all(vectors[i] == points[i]));
+}
+
+TEST(Math, Geometry)
+{
+    //相机位于原点并朝向z轴正方向
+    Frustum frustum = Frustum::FromMatrix(float4x4::Perspective(60.0f, 16.0f / 9.0f, 0.3f, 1000.0f));
+    ASSERT_TRUE(frustum.Intersects(AABB::FromCenterExtents({0, 0, 10}, 1)));
+    ASSERT_FALSE(frustum.Intersects(AABB::FromCenterExtents({0, 0, -10}, 1)));
+    ASSERT_FALSE(frustum.Intersects(AABB::FromCenterExtents({100, 0, 10}, 1)));
+    ASSERT_FALSE(frustum.Intersects(AABB::FromCenterExtents({0, 0, 1010}, 1)));
+    ASSERT_TRUE(frustum.Intersects(AABB::FromCenterExtents({0, 0, 0}, 1)));
+    ASSERT_TRUE(frustum.Intersects(Sphere{{0, 0, 1000}, 1}));
+    ASSERT_FALSE(frustum.Intersects(Sphere{{0, 20, 10}, 1}));
+
+    AABB box = AABB::FromCenterExtents({1, 2, 3}, {1, 2, 3});
+    ASSERT_TRUE(box.Contains({1, 2, 3}));
+    ASSERT_FALSE(box.Contains({3, 2, 3}));
+    ASSERT_TRUE(box.Intersects(AABB::FromCenterExtents({2, 2, 3}, 1)));
+    AABB transformedBox = box.Transform(float4x4::TRS({1, 0, 0}, {0, 90, 0}, 1));
+    ASSERT_TRUE(all(transformedBox.GetCenter() == float3(4, 2, -1)));
+    ASSERT_TRUE(all(transformedBox.GetExtents() == float3(3, 2, 1)));
+
+    //批量剔除结果应与逐个测试一致，101个元素可覆盖每次8个、每次4个以及逐个处理的情况
+    std::vector<AABB> boxes;
+    std::vector<Sphere> spheres;
+    for (int i = 0; i < 101; i++)
+    {
+        float3 center = {static_cast<float>(i % 11) * 4 - 20, static_cast<float>(i % 7) * 3 - 9, static_cast<float>(i) * 3 - 100};
+        boxes.push_back(AABB::FromCenterExtents(center, {1, 2, 3}));
+        spheres.push_back({center, 2});
+    }
+    std::vector<uint32_t> boxMasks(4);
+    CullAABBs(frustum, boxes, boxMasks);
+    std::vector<uint32_t> sphereMasks(4);
+    CullSpheres(frustum, spheres, sphereMasks);
+    int visibleCount = 0;
+    for (int i = 0; i < 101; i++)
+    {
+        ASSERT_EQ((boxMasks[i / 32] >> (i % 32) & 1) == 1, frustum.Intersects(boxes[i]));
+        ASSERT_EQ((sphereMasks[i / 32] >> (i % 32) & 1) == 1, frustum.Intersects(spheres[i]));
+        visibleCount += frustum.Intersects(boxes[i]);
+    }
+    ASSERT_GT(visibleCount, 0);
+    ASSERT_LT(visibleCount, 101);
+
+    //恰好与平面相切的包围体，两种实现的舍入误差也应相同
+    std::vector<AABB> touchingBoxes;
+    std::vector<Sphere> touchingSpheres;
+    for (const Plane& plane : frustum.planes)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            float radius = 1 + static_cast<float>(k) * 0.37f;
+            float3 center = plane.normal * (-plane.distance - radius) + float3(0, 0, 5);
+            touchingSpheres.push_back({center, radius});
+            float3 extents = float3(radius, radius * 0.5f, radius * 2);
+            touchingBoxes.push_back(AABB::FromCenterExtents(plane.normal * (-plane.distance - plane.GetProjectedRadius(extents)), extents));
+        }
+    }
+    CullAABBs(frustum, touchingBoxes, boxMasks);
+    CullSpheres(frustum, touchingSpheres, sphereMasks);
+    for (int i = 0; i < 48; i++)
+    {
+        ASSERT_EQ((boxMasks[i / 32] >> (i % 32) & 1) == 1, frustum.Intersects(touchingBoxes[i]));
+        ASSERT_EQ((sphereMasks[i / 32] >> (i % 32) & 1) == 1, frustum.Intersects(touchingSpheres[i]));
+    }
+}
+
+TEST(Math, PackedVector)
+{
+    ASSERT_EQ(half(1.0f).bits, 0x3C00);
+    ASSERT_EQ(half(-2.0f).bits, 0xC000);
+    ASSERT_EQ(half(0.1f).bits, 0x2E66);
+    ASSERT_EQ(half(65504.0f).bits, 0x7BFF); //最大值
+    ASSERT_EQ(half(65520.0f).bits, 0x7C00); //溢出为无穷大
+    ASSERT_EQ(half(5.9604645e-8f).bits, 0x0001); //最小的非规格化数
+    ASSERT_FLOAT_EQ(half(5.9604645e-8f), 5.9604645e-8f);
+    ASSERT_FLOAT_EQ(half(0.333f), 0.33300781f);
+
+    ASSERT_EQ(unorm8(1.0f).value, 255);
+    ASSERT_EQ(unorm8(2.0f).value, 255);
+    ASSERT_EQ(unorm8(0.5f).value, 128);
+    ASSERT_EQ(snorm8(-1.0f).value, -127);
+    ASSERT_FLOAT_EQ(snorm8(-1.0f), -1.0f);
+    ASSERT_FLOAT_EQ(snorm16(0.0f), 0.0f);
+
+    half4 color = pack<half>(float4(0.25f, 0.5f, 0.75f, 1));
+    ASSERT_TRUE(all(unpack(color) == float4(0.25f, 0.5f, 0.75f, 1)));
+    unorm8x4 color8 = pack<unorm8>(float4(0.25f, 0.5f, 0.75f, 1));
+    float4 color8Error = abs(unpack(color8) - float4(0.25f, 0.5f, 0.75f, 1));
+    ASSERT_LE(max(max(color8Error.x, color8Error.y), max(color8Error.z, color8Error.w)), 0.51f / 255);
+
+    //八面体编码的误差应在千分之一以内，需覆盖上下半球及坐标轴方向
+    for (float3 direction : {float3(0, 0, 1), float3(0, 0, -1), float3(1, 0, 0), float3(0, -1, 0), float3(1, 2, 3), float3(-3, 1, -2), float3(2, -5, -1)})
+    {
+        direction = normalize(direction);
+        ASSERT_LT(length(octahedral::Encode(direction).Decode() - direction), 1e-3f);
+    }
+
+    //批量转换的结果应与逐个转换一致，21个元素可覆盖每次8个、每次4个以及逐个处理的情况
+    std::vector<float> values;
+    for (int i = 0; i < 21; i++)
+        values.push_back(static_cast<float>(i) * 1.37f - 10);
+    std::vector<half> halfs(values.size());
+    PackHalfs(values, halfs);
+    std::vector<float> unpacked(values.size());
+    UnpackHalfs(halfs, unpacked);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        ASSERT_EQ(halfs[i].bits, half(values[i]).bits);
+        ASSERT_EQ(unpacked[i], static_cast<float>(half(values[i])));
+    }
+}
@@ -5,13 +5,31 @@
 
 namespace Light
 {
-    class BinaryReader : public Serializer
+    class BinaryReader final : public Serializer
     {
     public:
         BinaryReader(std::basic_istream<char>& stream);
 
         void Transfer(void* value, std::type_index type) override;
 
+        /**
+         * 编译期分派的传输函数，与BinaryWriter对应
+         */
+        template <class TValue>
+        void TransferField(const char*, TValue& value)
+        {
+            //二进制数据按顺序存储，不记录字段名
+            Transfer(value);
+        }
+        template <class TValue>
+        void Transfer(TValue& value)
+        {
+            if constexpr (BitwiseTransferable<TValue> || BitwiseTransferableContainer<TValue>)
+                Read(value);
+            else
+                SerializerTransfer<TValue>::Invoke(*this, value);
+        }
+
         template <class TValue>
         void Read(TValue& value)
         {
@@ -24,7 +42,7 @@ namespace Light
             int count;
             Read(count);
             buffer.resize(count);
-            stream->read(reinterpret_cast<char*>(std::data(buffer)), count);
+            stream->read(reinterpret_cast<char*>(std::data(buffer)), count * sizeof(*std::data(buffer)));
         }
 
     private:
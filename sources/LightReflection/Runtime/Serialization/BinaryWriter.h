@@ -5,13 +5,34 @@
 
 namespace Light
 {
-    class BinaryWriter : public Serializer
+    class BinaryWriter final : public Serializer
     {
     public:
         BinaryWriter(std::basic_ostream<char>& stream);
 
         void Transfer(void* value, std::type_index type) override;
 
+        /**
+         * 编译期分派的传输函数，可直接传输的类型及其容器不经过虚函数，其余类型交由SerializerTransfer处理，
+         * 其中的容器元素和嵌套字段仍会回到这里分派，只有其他基础类型（如字符串）才经过虚函数
+         *
+         * 生成的数据与虚函数路径完全一致，因此可以和任意Serializer混用。
+         */
+        template <class TValue>
+        void TransferField(const char*, TValue& value)
+        {
+            //二进制数据按顺序存储，不记录字段名
+            Transfer(value);
+        }
+        template <class TValue>
+        void Transfer(TValue& value)
+        {
+            if constexpr (BitwiseTransferable<TValue> || BitwiseTransferableContainer<TValue>)
+                Write(value);
+            else
+                SerializerTransfer<TValue>::Invoke(*this, value);
+        }
+
         template <class TValue>
         void Write(const TValue& value)
         {
@@ -23,7 +44,7 @@ namespace Light
         {
             int count = static_cast<int>(std::size(buffer));
             Write(count);
-            stream->write(reinterpret_cast<const char*>(std::data(buffer)), count);
+            stream->write(reinterpret_cast<const char*>(std::data(buffer)), count * sizeof(*std::data(buffer)));
         }
 
     private:
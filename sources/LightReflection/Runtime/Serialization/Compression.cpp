@@ -0,0 +1,442 @@
+#include "Compression.h"
+
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace Light
+{
+    //数据格式与LZ4块格式类似，由若干序列组成，每个序列包含：
+    //标记字节（高4位为字面量长度，低4位为匹配长度-MinMatch） | 扩展的字面量长度 | 字面量 | 2字节匹配偏移 | 扩展的匹配长度
+    //最后一个序列只有字面量
+
+    constexpr size_t MinMatch = 4;
+    constexpr size_t LastLiterals = 5; //块末尾的这些字节总是作为字面量，使解压时的越界检查可以简化
+    constexpr size_t MatchSafeDistance = 12; //距块末尾不足该距离的位置不再查找匹配
+    static_assert(Compression::BlockSize <= 65536, "匹配偏移使用2字节存储，块大小不能超过64KB！");
+
+    static uint32_t Read32(const uint8_t* address)
+    {
+        uint32_t value;
+        std::memcpy(&value, address, sizeof(uint32_t));
+        return value;
+    }
+    static uint64_t Read64(const uint8_t* address)
+    {
+        uint64_t value;
+        std::memcpy(&value, address, sizeof(uint64_t));
+        return value;
+    }
+
+    static uint8_t* WriteLength(uint8_t* output, size_t length)
+    {
+        while (length >= 255)
+        {
+            *output++ = 255;
+            length -= 255;
+        }
+        *output++ = static_cast<uint8_t>(length);
+        return output;
+    }
+    static size_t ReadLength(const uint8_t*& input, const uint8_t* inputEnd)
+    {
+        size_t length = 0;
+        uint8_t value;
+        do
+        {
+            if (input >= inputEnd)
+                throw std::runtime_error("压缩数据已损坏！");
+            value = *input++;
+            length += value;
+        }
+        while (value == 255);
+        return length;
+    }
+
+    /**
+     * @tparam HashLog 哈希表大小的对数
+     * @tparam SkipShift 查找失败时步长增长的速度，越小则越快地跳过难以压缩的数据
+     */
+    template <int HashLog, int SkipShift>
+    static size_t CompressSequences(const uint8_t* source, const size_t size, uint8_t* destination)
+    {
+        const uint8_t* input = source;
+        const uint8_t* anchor = source; //尚未输出的字面量的起点
+        uint8_t* output = destination;
+
+        if (size > MatchSafeDistance)
+        {
+            //块不超过64KB，因此位置可以用16位整数存储
+            uint16_t table[1 << HashLog] = {};
+            auto hash = [](const uint32_t sequence)
+            {
+                return sequence * 2654435761u >> (32 - HashLog);
+            };
+
+            const uint8_t* matchLimit = source + size - LastLiterals;
+            const uint8_t* inputLimit = source + size - MatchSafeDistance;
+            input++;
+
+            while (true)
+            {
+                //查找匹配
+                const uint8_t* match;
+                size_t attempts = 1 << SkipShift;
+                while (true)
+                {
+                    if (input > inputLimit)
+                        goto LastSequence;
+
+                    const uint32_t sequence = Read32(input);
+                    uint16_t& entry = table[hash(sequence)];
+                    match = source + entry;
+                    entry = static_cast<uint16_t>(input - source);
+                    if (match < input && Read32(match) == sequence)
+                        break;
+
+                    input += attempts++ >> SkipShift;
+                }
+
+                //向前扩展匹配
+                while (input > anchor && match > source && input[-1] == match[-1])
+                {
+                    input--;
+                    match--;
+                }
+
+                //向后扩展匹配，每次比较8字节
+                const uint8_t* matchEnd = input + MinMatch;
+                const uint8_t* matchCursor = match + MinMatch;
+                while (matchEnd + 8 <= matchLimit)
+                {
+                    const uint64_t difference = Read64(matchEnd) ^ Read64(matchCursor);
+                    if (difference != 0)
+                    {
+                        matchEnd += std::countr_zero(difference) / 8;
+                        goto MatchFound;
+                    }
+                    matchEnd += 8;
+                    matchCursor += 8;
+                }
+                while (matchEnd < matchLimit && *matchEnd == *matchCursor)
+                {
+                    matchEnd++;
+                    matchCursor++;
+                }
+            MatchFound:
+
+                //输出序列
+                const size_t literalLength = input - anchor;
+                const size_t matchLength = matchEnd - input - MinMatch;
+                const size_t offset = input - match;
+                uint8_t* token = output++;
+                *token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4 | (matchLength >= 15 ? 15 : matchLength));
+                if (literalLength >= 15)
+                    output = WriteLength(output, literalLength - 15);
+                std::memcpy(output, anchor, literalLength);
+                output += literalLength;
+                *output++ = static_cast<uint8_t>(offset);
+                *output++ = static_cast<uint8_t>(offset >> 8);
+                if (matchLength >= 15)
+                    output = WriteLength(output, matchLength - 15);
+
+                input = matchEnd;
+                anchor = input;
+                if (input > inputLimit)
+                    break;
+                //补充记录匹配内部的位置，以提高后续的命中率
+                table[hash(Read32(input - 2))] = static_cast<uint16_t>(input - 2 - source);
+            }
+        }
+
+    LastSequence:
+        const size_t literalLength = source + size - anchor;
+        *output++ = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+        if (literalLength >= 15)
+            output = WriteLength(output, literalLength - 15);
+        std::memcpy(output, anchor, literalLength);
+        output += literalLength;
+        return output - destination;
+    }
+
+    size_t Compression::GetMaxCompressedSize(const size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+    size_t Compression::CompressBlock(const std::span<const std::byte> source, const std::span<std::byte> destination, const CompressionLevel level)
+    {
+        if (source.size() > BlockSize)
+            throw std::runtime_error("压缩块过大！");
+        if (destination.size() < GetMaxCompressedSize(source.size()))
+            throw std::runtime_error("输出缓冲区不足！");
+
+        const uint8_t* input = reinterpret_cast<const uint8_t*>(source.data());
+        uint8_t* output = reinterpret_cast<uint8_t*>(destination.data());
+        if (level == CompressionLevel::Fast)
+            return CompressSequences<12, 5>(input, source.size(), output);
+        return CompressSequences<14, 8>(input, source.size(), output);
+    }
+    size_t Compression::DecompressBlock(const std::span<const std::byte> source, const std::span<std::byte> destination)
+    {
+        const uint8_t* input = reinterpret_cast<const uint8_t*>(source.data());
+        const uint8_t* inputEnd = input + source.size();
+        uint8_t* outputStart = reinterpret_cast<uint8_t*>(destination.data());
+        uint8_t* output = outputStart;
+        uint8_t* outputEnd = output + destination.size();
+
+        while (true)
+        {
+            if (input >= inputEnd)
+                throw std::runtime_error("压缩数据已损坏！");
+            const uint8_t token = *input++;
+
+            //复制字面量，空间充足时固定复制16字节以避免变长复制的开销
+            size_t literalLength = token >> 4;
+            if (literalLength == 15)
+                literalLength += ReadLength(input, inputEnd);
+            if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output))
+                throw std::runtime_error("压缩数据已损坏！");
+            if (literalLength <= 16 && inputEnd - input >= 16 && outputEnd - output >= 16)
+                std::memcpy(output, input, 16);
+            else
+                std::memcpy(output, input, literalLength);
+            input += literalLength;
+            output += literalLength;
+
+            //最后一个序列只有字面量
+            if (input == inputEnd)
+                break;
+
+            //复制匹配
+            if (inputEnd - input < 2)
+                throw std::runtime_error("压缩数据已损坏！");
+            const size_t offset = input[0] | input[1] << 8;
+            input += 2;
+            size_t matchLength = token & 15;
+            if (matchLength == 15)
+                matchLength += ReadLength(input, inputEnd);
+            matchLength += MinMatch;
+            if (offset == 0 || offset > static_cast<size_t>(output - outputStart) || matchLength > static_cast<size_t>(outputEnd - output))
+                throw std::runtime_error("压缩数据已损坏！");
+
+            const uint8_t* match = output - offset;
+            uint8_t* matchEnd = output + matchLength;
+            if (offset >= 8 && outputEnd - matchEnd >= 8)
+            {
+                //偏移不小于8时每次复制8字节不会读到本次写入的数据，末尾多写的部分会被后续数据覆盖
+                do
+                {
+                    std::memcpy(output, match, 8);
+                    output += 8;
+                    match += 8;
+                }
+                while (output < matchEnd);
+            }
+            else if (offset == 1)
+            {
+                std::memset(output, *match, matchLength);
+            }
+            else
+            {
+                for (size_t i = 0; i < matchLength; i++)
+                    output[i] = match[i];
+            }
+            output = matchEnd;
+        }
+
+        return output - outputStart;
+    }
+
+    std::vector<std::byte> Compression::Compress(const std::span<const std::byte> data, const CompressionLevel level)
+    {
+        std::vector<std::byte> result;
+        result.reserve(data.size() / 2);
+        for (size_t rawOffset = 0; rawOffset < data.size(); rawOffset += BlockSize)
+        {
+            const std::span<const std::byte> rawBlock = data.subspan(rawOffset, std::min(BlockSize, data.size() - rawOffset));
+            const size_t headerOffset = result.size();
+            result.resize(headerOffset + sizeof(CompressedBlockHeader) + GetMaxCompressedSize(rawBlock.size()));
+
+            CompressedBlockHeader header = {static_cast<uint32_t>(rawBlock.size()), 0};
+            const std::span<std::byte> block = std::span(result).subspan(headerOffset + sizeof(CompressedBlockHeader));
+            const size_t compressedSize = CompressBlock(rawBlock, block, level);
+            if (compressedSize < rawBlock.size())
+            {
+                header.storedSize = static_cast<uint32_t>(compressedSize);
+            }
+            else
+            {
+                header.storedSize = static_cast<uint32_t>(rawBlock.size()) | CompressedBlockHeader::StoredFlag;
+                std::memcpy(block.data(), rawBlock.data(), rawBlock.size());
+            }
+            std::memcpy(result.data() + headerOffset, &header, sizeof(CompressedBlockHeader));
+            result.resize(headerOffset + sizeof(CompressedBlockHeader) + (header.storedSize & ~CompressedBlockHeader::StoredFlag));
+        }
+        return result;
+    }
+    std::vector<CompressedBlockInfo> Compression::GetBlocks(const std::span<const std::byte> data)
+    {
+        std::vector<CompressedBlockInfo> blocks;
+        size_t offset = 0;
+        size_t rawOffset = 0;
+        while (offset < data.size())
+        {
+            CompressedBlockHeader header;
+            if (data.size() - offset < sizeof(CompressedBlockHeader))
+                throw std::runtime_error("压缩数据已损坏！");
+            std::memcpy(&header, data.data() + offset, sizeof(CompressedBlockHeader));
+            offset += sizeof(CompressedBlockHeader);
+
+            CompressedBlockInfo& block = blocks.emplace_back();
+            block.offset = offset;
+            block.storedSize = header.storedSize & ~CompressedBlockHeader::StoredFlag;
+            block.rawOffset = rawOffset;
+            block.rawSize = header.rawSize;
+            block.isStored = (header.storedSize & CompressedBlockHeader::StoredFlag) != 0;
+            if (block.storedSize > data.size() - offset || block.rawSize > BlockSize)
+                throw std::runtime_error("压缩数据已损坏！");
+
+            offset += block.storedSize;
+            rawOffset += block.rawSize;
+        }
+        return blocks;
+    }
+    std::vector<std::byte> Compression::Decompress(const std::span<const std::byte> data, const int threadCount)
+    {
+        const std::vector<CompressedBlockInfo> blocks = GetBlocks(data);
+        std::vector<std::byte> result(blocks.empty() ? 0 : blocks.back().rawOffset + blocks.back().rawSize);
+
+        auto decompress = [&](const size_t begin, const size_t step)
+        {
+            for (size_t i = begin; i < blocks.size(); i += step)
+            {
+                const CompressedBlockInfo& block = blocks[i];
+                const std::span<const std::byte> source = data.subspan(block.offset, block.storedSize);
+                const std::span<std::byte> destination = std::span(result).subspan(block.rawOffset, block.rawSize);
+                if (block.isStored)
+                {
+                    if (block.storedSize != block.rawSize)
+                        throw std::runtime_error("压缩数据已损坏！");
+                    std::memcpy(destination.data(), source.data(), block.storedSize);
+                }
+                else if (DecompressBlock(source, destination) != block.rawSize)
+                {
+                    throw std::runtime_error("压缩数据已损坏！");
+                }
+            }
+        };
+
+        const size_t workerCount = std::min(static_cast<size_t>(std::max(threadCount, 1)), blocks.size());
+        if (workerCount <= 1)
+        {
+            decompress(0, 1);
+            return result;
+        }
+
+        //各线程交错领取块，异常在所有线程结束后重新抛出
+        std::vector<std::exception_ptr> exceptions(workerCount);
+        {
+            std::vector<std::jthread> workers;
+            for (size_t i = 1; i < workerCount; i++)
+            {
+                workers.emplace_back([&, i]
+                {
+                    try { decompress(i, workerCount); }
+                    catch (...) { exceptions[i] = std::current_exception(); }
+                });
+            }
+            try { decompress(0, workerCount); }
+            catch (...) { exceptions[0] = std::current_exception(); }
+        }
+        for (const std::exception_ptr& exception : exceptions)
+            if (exception)
+                std::rethrow_exception(exception);
+        return result;
+    }
+
+    CompressionStreamBuffer::CompressionStreamBuffer(std::basic_ostream<char>& stream, const CompressionLevel level)
+        : stream(&stream), level(level),
+          rawBuffer(Compression::BlockSize), compressedBuffer(Compression::GetMaxCompressedSize(Compression::BlockSize))
+    {
+        setp(rawBuffer.data(), rawBuffer.data() + rawBuffer.size());
+    }
+    CompressionStreamBuffer::~CompressionStreamBuffer()
+    {
+        WriteBlock();
+    }
+    CompressionStreamBuffer::int_type CompressionStreamBuffer::overflow(const int_type value)
+    {
+        WriteBlock();
+        if (!traits_type::eq_int_type(value, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(value);
+            pbump(1);
+        }
+        return traits_type::not_eof(value);
+    }
+    int CompressionStreamBuffer::sync()
+    {
+        WriteBlock();
+        stream->flush();
+        return stream->good() ? 0 : -1;
+    }
+    void CompressionStreamBuffer::WriteBlock()
+    {
+        const size_t rawSize = pptr() - pbase();
+        if (rawSize == 0)
+            return;
+
+        const std::span<const std::byte> rawBlock = {reinterpret_cast<const std::byte*>(pbase()), rawSize};
+        const size_t compressedSize = Compression::CompressBlock(rawBlock, compressedBuffer, level);
+        CompressedBlockHeader header = {static_cast<uint32_t>(rawSize), 0};
+        if (compressedSize < rawSize)
+        {
+            header.storedSize = static_cast<uint32_t>(compressedSize);
+            stream->write(reinterpret_cast<const char*>(&header), sizeof(CompressedBlockHeader));
+            stream->write(reinterpret_cast<const char*>(compressedBuffer.data()), static_cast<std::streamsize>(compressedSize));
+        }
+        else
+        {
+            header.storedSize = static_cast<uint32_t>(rawSize) | CompressedBlockHeader::StoredFlag;
+            stream->write(reinterpret_cast<const char*>(&header), sizeof(CompressedBlockHeader));
+            stream->write(pbase(), static_cast<std::streamsize>(rawSize));
+        }
+
+        setp(rawBuffer.data(), rawBuffer.data() + rawBuffer.size());
+    }
+
+    DecompressionStreamBuffer::DecompressionStreamBuffer(std::basic_istream<char>& stream)
+        : stream(&stream), rawBuffer(Compression::BlockSize), compressedBuffer(Compression::BlockSize)
+    {
+        setg(rawBuffer.data(), rawBuffer.data(), rawBuffer.data());
+    }
+    DecompressionStreamBuffer::int_type DecompressionStreamBuffer::underflow()
+    {
+        CompressedBlockHeader header;
+        if (!stream->read(reinterpret_cast<char*>(&header), sizeof(CompressedBlockHeader)))
+            return traits_type::eof();
+
+        const size_t storedSize = header.storedSize & ~CompressedBlockHeader::StoredFlag;
+        if (header.rawSize > Compression::BlockSize || storedSize > Compression::GetMaxCompressedSize(Compression::BlockSize))
+            throw std::runtime_error("压缩数据已损坏！");
+
+        if (header.storedSize & CompressedBlockHeader::StoredFlag)
+        {
+            if (storedSize != header.rawSize || !stream->read(rawBuffer.data(), static_cast<std::streamsize>(storedSize)))
+                throw std::runtime_error("压缩数据已损坏！");
+        }
+        else
+        {
+            compressedBuffer.resize(storedSize);
+            if (!stream->read(reinterpret_cast<char*>(compressedBuffer.data()), static_cast<std::streamsize>(storedSize)))
+                throw std::runtime_error("压缩数据已损坏！");
+            if (Compression::DecompressBlock(compressedBuffer, std::as_writable_bytes(std::span(rawBuffer))) != header.rawSize)
+                throw std::runtime_error("压缩数据已损坏！");
+        }
+
+        setg(rawBuffer.data(), rawBuffer.data(), rawBuffer.data() + header.rawSize);
+        return header.rawSize == 0 ? traits_type::eof() : traits_type::to_int_type(rawBuffer[0]);
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+//LZ系列的块压缩，数据被切分为互相独立的块，因此可以多线程并行解压
+//压缩数据的布局为依次存放的块：CompressedBlockHeader | 块数据
+
+namespace Light
+{
+    enum class CompressionLevel
+    {
+        Fast, //压缩速度优先，遇到难以压缩的数据时会加快跳过
+        Balanced, //使用更大的哈希表并逐字节查找，压缩率更高
+    };
+
+    struct CompressedBlockHeader
+    {
+        constexpr static uint32_t StoredFlag = 0x80000000; //块数据无法压缩，按原样存储
+
+        uint32_t rawSize;
+        uint32_t storedSize; //最高位为StoredFlag
+    };
+
+    struct CompressedBlockInfo
+    {
+        size_t offset; //块数据在压缩数据中的偏移，不含块头
+        size_t storedSize;
+        size_t rawOffset; //解压后在原数据中的偏移
+        size_t rawSize;
+        bool isStored;
+    };
+
+    class Compression
+    {
+    public:
+        constexpr static size_t BlockSize = 64 * 1024;
+
+        /**
+         * @param size 原数据大小
+         * @return 压缩单个块时输出缓冲区所需的最大大小
+         */
+        static size_t GetMaxCompressedSize(size_t size);
+        /**
+         * 压缩单个块
+         * @param source 原数据，不能超过BlockSize
+         * @param destination 输出缓冲区，大小需不小于GetMaxCompressedSize
+         * @param level
+         * @return 压缩后的大小
+         */
+        static size_t CompressBlock(std::span<const std::byte> source, std::span<std::byte> destination, CompressionLevel level = CompressionLevel::Fast);
+        /**
+         * 解压单个块，数据损坏时抛出异常
+         * @param source 压缩后的数据
+         * @param destination 输出缓冲区
+         * @return 解压后的大小
+         */
+        static size_t DecompressBlock(std::span<const std::byte> source, std::span<std::byte> destination);
+
+        /**
+         * 将数据切分为块后压缩，结果与CompressionStreamBuffer输出的格式相同
+         * @param data
+         * @param level
+         * @return
+         */
+        static std::vector<std::byte> Compress(std::span<const std::byte> data, CompressionLevel level = CompressionLevel::Fast);
+        /**
+         * 解析压缩数据中所有块的位置，可用于自行分配解压任务
+         * @param data
+         * @return
+         */
+        static std::vector<CompressedBlockInfo> GetBlocks(std::span<const std::byte> data);
+        /**
+         * 解压所有块
+         * @param data
+         * @param threadCount 用于解压的线程数，各块会平均分配给这些线程
+         * @return
+         */
+        static std::vector<std::byte> Decompress(std::span<const std::byte> data, int threadCount = 1);
+    };
+
+    /**
+     * 在写入流前压缩数据的流缓冲区，可配合BinaryWriter使用：
+     * @code
+     * CompressionStreamBuffer buffer = {fileStream};
+     * std::ostream stream(&buffer);
+     * BinaryWriter writer = {stream};
+     * @endcode
+     * 写满一个块或调用flush时输出一个压缩块，析构时会输出剩余的数据。
+     */
+    class CompressionStreamBuffer : public std::streambuf
+    {
+    public:
+        CompressionStreamBuffer(std::basic_ostream<char>& stream, CompressionLevel level = CompressionLevel::Fast);
+        CompressionStreamBuffer(const CompressionStreamBuffer&) = delete;
+        ~CompressionStreamBuffer() override;
+
+    protected:
+        int_type overflow(int_type value) override;
+        int sync() override;
+
+    private:
+        std::basic_ostream<char>* stream;
+        CompressionLevel level;
+        std::vector<char> rawBuffer;
+        std::vector<std::byte> compressedBuffer;
+
+        void WriteBlock();
+    };
+
+    /**
+     * 从流中读取压缩数据并解压的流缓冲区，可配合BinaryReader使用
+     */
+    class DecompressionStreamBuffer : public std::streambuf
+    {
+    public:
+        DecompressionStreamBuffer(std::basic_istream<char>& stream);
+        DecompressionStreamBuffer(const DecompressionStreamBuffer&) = delete;
+
+    protected:
+        int_type underflow() override;
+
+    private:
+        std::basic_istream<char>* stream;
+        std::vector<char> rawBuffer;
+        std::vector<std::byte> compressedBuffer;
+    };
+}
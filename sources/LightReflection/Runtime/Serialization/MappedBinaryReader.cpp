@@ -0,0 +1,48 @@
+#include "MappedBinaryReader.h"
+
+namespace Light
+{
+    MappedBinaryReader::MappedBinaryReader(const std::span<const std::byte> data)
+        : data(data), position(0)
+    {
+    }
+    MappedBinaryReader::MappedBinaryReader(const MappedFile& file)
+        : MappedBinaryReader(file.GetData())
+    {
+    }
+
+    size_t MappedBinaryReader::GetPosition() const
+    {
+        return position;
+    }
+    size_t MappedBinaryReader::GetRemainingSize() const
+    {
+        return data.size() - position;
+    }
+
+    void MappedBinaryReader::Transfer(void* value, const std::type_index type)
+    {
+#define MakeTransfer(valueType) if (type == typeid(valueType)){Read(*static_cast<valueType##*>(value));return;}
+        MakeTransfer(float)
+        MakeTransfer(int)
+        MakeTransfer(bool)
+        MakeTransfer(char)
+        MakeTransfer(std::string)
+        MakeTransfer(std::vector<std::byte>)
+        MakeTransfer(size_t)
+        MakeTransfer(uint32_t)
+#undef MakeTransfer
+
+        throw std::runtime_error("不支持的传输类型！");
+    }
+
+    const std::byte* MappedBinaryReader::Take(const size_t size)
+    {
+        if (size > data.size() - position)
+            throw std::runtime_error("读取越界！");
+
+        const std::byte* result = data.data() + position;
+        position += size;
+        return result;
+    }
+}
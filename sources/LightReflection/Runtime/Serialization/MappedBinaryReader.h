@@ -0,0 +1,95 @@
+#pragma once
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "Serializer.hpp"
+#include "LightUtility/Runtime/MappedFile.h"
+
+namespace Light
+{
+    /**
+     * 直接从内存中读取BinaryWriter写入的数据，功能与BinaryReader相同
+     *
+     * 不经过流，读取时会检查越界。对于大块数据，可通过ReadView直接获取指向源内存的视图，从而避免复制。
+     */
+    class MappedBinaryReader final : public Serializer
+    {
+    public:
+        /**
+         * @param data 需在读取器使用期间保持有效
+         */
+        MappedBinaryReader(std::span<const std::byte> data);
+        /**
+         * @param file 需在读取器使用期间保持有效
+         */
+        MappedBinaryReader(const MappedFile& file);
+
+        size_t GetPosition() const;
+        size_t GetRemainingSize() const;
+
+        void Transfer(void* value, std::type_index type) override;
+
+        /**
+         * 编译期分派的传输函数，与BinaryWriter对应
+         */
+        template <class TValue>
+        void TransferField(const char*, TValue& value)
+        {
+            //二进制数据按顺序存储，不记录字段名
+            Transfer(value);
+        }
+        template <class TValue>
+        void Transfer(TValue& value)
+        {
+            if constexpr (BitwiseTransferable<TValue> || BitwiseTransferableContainer<TValue>)
+                Read(value);
+            else
+                SerializerTransfer<TValue>::Invoke(*this, value);
+        }
+
+        template <class TValue>
+        void Read(TValue& value)
+        {
+            std::memcpy(&value, Take(sizeof(TValue)), sizeof(TValue));
+        }
+        template <class TBuffer>
+            requires requires(TBuffer& buffer) { buffer.resize(0);std::data(buffer); }
+        void Read(TBuffer& buffer)
+        {
+            int count;
+            Read(count);
+            const size_t size = count * sizeof(*std::data(buffer));
+            const std::byte* source = Take(size);
+            buffer.resize(count);
+            std::memcpy(std::data(buffer), source, size);
+        }
+        /**
+         * 以零复制的方式读取一个由BinaryWriter写入的数组，如std::vector<std::byte>或平凡类型的数组
+         * @tparam TValue 数组元素类型
+         * @return 指向源内存的视图，源数据中该数组的地址需满足TValue的对齐要求
+         */
+        template <class TValue>
+            requires std::is_trivially_copyable_v<TValue>
+        std::span<const TValue> ReadView()
+        {
+            int count;
+            Read(count);
+            const std::byte* source = Take(count * sizeof(TValue));
+            if (reinterpret_cast<uintptr_t>(source) % alignof(TValue) != 0)
+                throw std::runtime_error("数据未对齐，无法创建视图！");
+            return {reinterpret_cast<const TValue*>(source), static_cast<size_t>(count)};
+        }
+
+    private:
+        std::span<const std::byte> data;
+        size_t position;
+
+        /**
+         * 取出指定大小的数据并前移读取位置
+         * @param size
+         * @return 数据起始地址，剩余数据不足时抛出异常
+         */
+        const std::byte* Take(size_t size);
+    };
+}
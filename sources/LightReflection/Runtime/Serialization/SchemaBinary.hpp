@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+//自描述的二进制格式，数据布局如下：
+//SchemaHeader | SchemaField[fieldCount] | 各字段数据
+//字段表由Type::fieldInfos生成，读取时按名称匹配字段，因此结构体增删字段或调整顺序后旧数据仍可读取
+
+namespace Light
+{
+    constexpr uint32_t SchemaMagic = 0x3142534C; //"LSB1"
+
+    struct SchemaHeader
+    {
+        uint32_t magic;
+        uint32_t fieldCount;
+        uint8_t uuid[16]; //数据对应的类型
+        uint64_t dataSize; //字段数据的总大小，不含头部和字段表
+    };
+
+    struct SchemaField
+    {
+        uint64_t nameHash;
+        uint64_t typeHash;
+        uint64_t dataOffset; //相对字段数据起始处的偏移
+        uint32_t dataSize; //可直接复制内存的字段等于其类型大小，否则为序列化后的大小
+        uint32_t isBitwise;
+    };
+
+    /**
+     * 计算字段名称或类型名称的哈希值（FNV-1a）
+     * @note 类型名称来自type_info::name()，因此同一编译器生成的数据之间才能匹配类型
+     * @param name
+     * @return
+     */
+    constexpr uint64_t HashSchemaName(const std::string_view name)
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (const char c : name)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+}
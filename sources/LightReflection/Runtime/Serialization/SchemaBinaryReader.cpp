@@ -0,0 +1,102 @@
+#include "SchemaBinaryReader.h"
+
+#include <cstring>
+
+namespace Light
+{
+    SchemaBinaryReader::SchemaBinaryReader(const std::span<const std::byte> data)
+    {
+        SchemaHeader header;
+        if (data.size() < sizeof(SchemaHeader))
+            throw std::runtime_error("数据长度不足！");
+        std::memcpy(&header, data.data(), sizeof(SchemaHeader));
+        if (header.magic != SchemaMagic)
+            throw std::runtime_error("不是有效的数据格式！");
+
+        const size_t tableSize = header.fieldCount * sizeof(SchemaField);
+        if (data.size() - sizeof(SchemaHeader) < tableSize || data.size() - sizeof(SchemaHeader) - tableSize < header.dataSize)
+            throw std::runtime_error("数据长度不足！");
+
+        uuid = uuids::uuid(std::begin(header.uuid), std::end(header.uuid));
+        //字段表复制出来，从而不要求源数据对齐
+        fields.resize(header.fieldCount);
+        std::memcpy(fields.data(), data.data() + sizeof(SchemaHeader), tableSize);
+        this->data = data.subspan(sizeof(SchemaHeader) + tableSize, header.dataSize);
+
+        for (const SchemaField& field : fields)
+            if (field.dataOffset > this->data.size() || field.dataSize > this->data.size() - field.dataOffset)
+                throw std::runtime_error("字段数据越界！");
+    }
+
+    const uuids::uuid& SchemaBinaryReader::GetUUID() const
+    {
+        return uuid;
+    }
+    const std::vector<SchemaField>& SchemaBinaryReader::GetFields() const
+    {
+        return fields;
+    }
+    size_t SchemaBinaryReader::GetSize() const
+    {
+        return sizeof(SchemaHeader) + fields.size() * sizeof(SchemaField) + data.size();
+    }
+
+    void SchemaBinaryReader::Read(const Type& type, void* object) const
+    {
+        std::byte* address = static_cast<std::byte*>(object);
+
+        //相邻的字段若在数据和对象中都连续存放，则合并为一次复制
+        const std::byte* copySource = nullptr;
+        std::byte* copyDestination = nullptr;
+        size_t copySize = 0;
+        auto flushCopy = [&]()
+        {
+            if (copySize != 0)
+                std::memcpy(copyDestination, copySource, copySize);
+            copySize = 0;
+        };
+
+        for (const FieldInfo& fieldInfo : type.fieldInfos)
+        {
+            const SchemaField* field = FindField(HashSchemaName(fieldInfo.name));
+            //字段已被删除或修改了类型，保持原值
+            if (field == nullptr || field->typeHash != HashSchemaName(fieldInfo.type.name()))
+                continue;
+
+            const std::span<const std::byte> fieldData = GetFieldData(*field);
+            std::byte* fieldAddress = address + fieldInfo.offset;
+            if (field->isBitwise && fieldInfo.isBitwise && field->dataSize == fieldInfo.size)
+            {
+                if (copySize != 0 && copySource + copySize == fieldData.data() && copyDestination + copySize == fieldAddress)
+                {
+                    copySize += fieldData.size();
+                }
+                else
+                {
+                    flushCopy();
+                    copySource = fieldData.data();
+                    copyDestination = fieldAddress;
+                    copySize = fieldData.size();
+                }
+            }
+            else if (!field->isBitwise && !fieldInfo.isBitwise)
+            {
+                MappedBinaryReader reader = {fieldData};
+                fieldInfo.transfer(reader, fieldAddress);
+            }
+        }
+        flushCopy();
+    }
+
+    const SchemaField* SchemaBinaryReader::FindField(const uint64_t nameHash) const
+    {
+        for (const SchemaField& field : fields)
+            if (field.nameHash == nameHash)
+                return &field;
+        return nullptr;
+    }
+    std::span<const std::byte> SchemaBinaryReader::GetFieldData(const SchemaField& field) const
+    {
+        return data.subspan(field.dataOffset, field.dataSize);
+    }
+}
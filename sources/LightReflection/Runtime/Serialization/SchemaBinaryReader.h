@@ -0,0 +1,80 @@
+#pragma once
+#include <span>
+
+#include "MappedBinaryReader.h"
+#include "SchemaBinary.hpp"
+#include "LightReflection/Runtime/Type.hpp"
+
+namespace Light
+{
+    /**
+     * 读取SchemaBinaryWriter写入的对象
+     *
+     * 构造时只解析头部和字段表，字段数据在读取时才会访问。读取时按字段名称匹配：
+     * 可直接复制内存的字段会按当前类型的偏移整块复制，数据中多出的字段直接跳过，数据中缺少的字段保持原值。
+     */
+    class SchemaBinaryReader
+    {
+    public:
+        /**
+         * @param data 以对象数据开头的内存，需在读取器使用期间保持有效，格式错误或长度不足时抛出异常
+         */
+        SchemaBinaryReader(std::span<const std::byte> data);
+
+        /**
+         * @return 写入时对象的类型
+         */
+        const uuids::uuid& GetUUID() const;
+        const std::vector<SchemaField>& GetFields() const;
+        /**
+         * @return 当前对象的数据总大小，可用于定位之后的下一个对象
+         */
+        size_t GetSize() const;
+
+        /**
+         * 读取所有能与当前类型匹配的字段
+         * @param type 当前的类型
+         * @param object
+         */
+        void Read(const Type& type, void* object) const;
+        template <class T>
+        void Read(T& object) const
+        {
+            Read(Type::GetType<T>(), &object);
+        }
+        /**
+         * 只读取单个字段
+         * @param name 字段名称
+         * @param value
+         * @return 数据中不存在该字段或类型不一致时返回false
+         */
+        template <class TValue>
+        bool ReadField(const char* name, TValue& value) const
+        {
+            const SchemaField* field = FindField(HashSchemaName(name));
+            if (field == nullptr || field->typeHash != HashSchemaName(typeid(TValue).name()) || (field->isBitwise != 0) != BitwiseTransferable<TValue>)
+                return false;
+
+            MappedBinaryReader reader = {GetFieldData(*field)};
+            if constexpr (BitwiseTransferable<TValue>)
+            {
+                if (field->dataSize != sizeof(TValue))
+                    return false;
+                reader.Read(value);
+            }
+            else
+            {
+                reader.Transfer(value);
+            }
+            return true;
+        }
+
+    private:
+        uuids::uuid uuid;
+        std::vector<SchemaField> fields;
+        std::span<const std::byte> data;
+
+        const SchemaField* FindField(uint64_t nameHash) const;
+        std::span<const std::byte> GetFieldData(const SchemaField& field) const;
+    };
+}
@@ -0,0 +1,51 @@
+#include "SchemaBinaryWriter.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "BinaryWriter.h"
+
+namespace Light
+{
+    SchemaBinaryWriter::SchemaBinaryWriter(std::basic_ostream<char>& stream)
+        : stream(&stream)
+    {
+    }
+
+    void SchemaBinaryWriter::Write(const Type& type, const void* object)
+    {
+        std::byte* address = const_cast<std::byte*>(static_cast<const std::byte*>(object));
+
+        //先将字段数据写入缓冲区，以确定各字段的偏移和大小
+        std::ostringstream dataStream;
+        BinaryWriter dataWriter = {dataStream};
+        std::vector<SchemaField> fields;
+        fields.reserve(type.fieldInfos.size());
+        for (const FieldInfo& fieldInfo : type.fieldInfos)
+        {
+            SchemaField& field = fields.emplace_back();
+            field.nameHash = HashSchemaName(fieldInfo.name);
+            field.typeHash = HashSchemaName(fieldInfo.type.name());
+            field.dataOffset = static_cast<uint64_t>(dataStream.tellp());
+            field.isBitwise = fieldInfo.isBitwise;
+
+            if (fieldInfo.isBitwise)
+                dataStream.write(reinterpret_cast<const char*>(address + fieldInfo.offset), static_cast<std::streamsize>(fieldInfo.size));
+            else
+                fieldInfo.transfer(dataWriter, address + fieldInfo.offset);
+
+            field.dataSize = static_cast<uint32_t>(static_cast<uint64_t>(dataStream.tellp()) - field.dataOffset);
+        }
+        const std::string data = std::move(dataStream).str();
+
+        SchemaHeader header = {};
+        header.magic = SchemaMagic;
+        header.fieldCount = static_cast<uint32_t>(fields.size());
+        std::memcpy(header.uuid, type.uuid.as_bytes().data(), sizeof(header.uuid));
+        header.dataSize = data.size();
+
+        stream->write(reinterpret_cast<const char*>(&header), sizeof(SchemaHeader));
+        stream->write(reinterpret_cast<const char*>(fields.data()), static_cast<std::streamsize>(fields.size() * sizeof(SchemaField)));
+        stream->write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+}
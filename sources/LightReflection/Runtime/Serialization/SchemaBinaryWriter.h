@@ -0,0 +1,32 @@
+#pragma once
+#include <ostream>
+
+#include "SchemaBinary.hpp"
+#include "LightReflection/Runtime/Type.hpp"
+
+namespace Light
+{
+    /**
+     * 以自描述格式写入已注册类型的对象，格式说明见SchemaBinary.hpp
+     */
+    class SchemaBinaryWriter
+    {
+    public:
+        SchemaBinaryWriter(std::basic_ostream<char>& stream);
+
+        /**
+         * 写入一个对象，多次调用时各对象的数据依次存放
+         * @param type 对象的类型，需包含字段信息
+         * @param object
+         */
+        void Write(const Type& type, const void* object);
+        template <class T>
+        void Write(const T& object)
+        {
+            Write(Type::GetType<T>(), &object);
+        }
+
+    private:
+        std::basic_ostream<char>* stream;
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 #include <typeindex>
 #include <vector>
 #include <string>
@@ -7,11 +8,33 @@
 
 namespace Light
 {
+    /**
+     * 标记可直接按内存传输的类型，默认包含算术类型和枚举
+     *
+     * 支持编译期分派的序列化器（如BinaryWriter）会直接复制此类值的内存，其所在的连续容器也会作为一整块传输。
+     * 对于平凡可复制且序列化结果与内存布局一致的类型（如数学向量、顶点结构体），可通过特化该变量启用。
+     */
+    template <class TValue>
+    constexpr bool EnableBitwiseTransfer = std::is_arithmetic_v<TValue> || std::is_enum_v<TValue>;
+
+    template <class TValue>
+    concept BitwiseTransferable = EnableBitwiseTransfer<TValue> && std::is_trivially_copyable_v<TValue>;
+    template <class TContainer>
+    concept BitwiseTransferableContainer = requires(TContainer& container) { container.resize(0);std::size(container);std::data(container); }
+        && BitwiseTransferable<std::remove_pointer_t<decltype(std::data(std::declval<TContainer&>()))>>;
+
     class Serializer;
+    /**
+     * 类型的传输方式，可通过特化自定义
+     *
+     * Invoke以序列化器的具体类型为模板参数：通过具体类型（如BinaryWriter）传输时，容器元素和嵌套字段也会使用其编译期分派的传输函数；
+     * 通过Serializer基类传输时则全部经过虚函数。
+     */
     template <class TValue>
     struct SerializerTransfer
     {
-        static void Invoke(Serializer& serializer, TValue& value);
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, TValue& value);
     };
 
     class Serializer
@@ -43,7 +66,8 @@ namespace Light
     static_assert(Transferrer<Serializer>);
 
     template <class TValue>
-    void SerializerTransfer<TValue>::Invoke(Serializer& serializer, TValue& value)
+    template <class TSerializer>
+    void SerializerTransfer<TValue>::Invoke(TSerializer& serializer, TValue& value)
     {
         serializer.Transfer(&value, typeid(TValue));
     }
@@ -52,7 +76,8 @@ namespace Light
         requires requires(TContainer container) { container.resize(0);std::size(container);std::begin(container);std::end(container); }
     struct SerializerTransfer<TContainer>
     {
-        static void Invoke(Serializer& serializer, TContainer& value)
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, TContainer& value)
         {
             int size = static_cast<int>(std::size(value));
             serializer.TransferField("size", size);
@@ -67,7 +92,8 @@ namespace Light
     template <>
     struct SerializerTransfer<std::vector<bool>>
     {
-        static void Invoke(Serializer& serializer, std::vector<bool>& value)
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, std::vector<bool>& value)
         {
             int size = static_cast<int>(std::size(value));
             serializer.TransferField("size", size);
@@ -86,7 +112,8 @@ namespace Light
     template <>
     struct SerializerTransfer<std::vector<std::byte>>
     {
-        static void Invoke(Serializer& serializer, std::vector<std::byte>& value)
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, std::vector<std::byte>& value)
         {
             serializer.Transfer(&value, typeid(std::vector<std::byte>));
         }
@@ -94,7 +121,8 @@ namespace Light
     template <>
     struct SerializerTransfer<std::string>
     {
-        static void Invoke(Serializer& serializer, std::string& value)
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, std::string& value)
         {
             serializer.Transfer(&value, typeid(std::string));
         }
@@ -0,0 +1,24 @@
+#pragma once
+#include "Serializer.hpp"
+#include "LightMath/Runtime/Vector.hpp"
+
+namespace Light
+{
+    /**
+     * 数学向量逐个分量传输
+     */
+    template <class Type, int Number>
+    struct SerializerTransfer<vector<Type, Number>>
+    {
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, vector<Type, Number>& value)
+        {
+            for (int i = 0; i < Number; i++)
+                serializer.Transfer(value.data[i]);
+        }
+    };
+
+    //向量的内存布局即为各分量依次排列，与逐个分量传输的结果一致
+    template <class Type, int Number>
+    constexpr bool EnableBitwiseTransfer<vector<Type, Number>> = EnableBitwiseTransfer<Type>;
+}
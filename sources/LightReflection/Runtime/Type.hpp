@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
@@ -16,6 +18,8 @@ namespace Light
         std::type_index type;
         std::ptrdiff_t offset;
         std::size_t size;
+        bool isBitwise; //是否可直接复制内存进行传输，见EnableBitwiseTransfer
+        void (*transfer)(Serializer&, void*); //单独传输该字段的函数，参数为字段地址
     };
 
     template <typename T>
@@ -36,38 +40,86 @@ namespace Light
         }
     };
 
+    /**
+     * 类型的唯一标识，由MakeType特化，value为编译期解析的UUID
+     */
+    template <typename T>
+    struct TypeID;
+
+    /**
+     * 通过MakeType注册的类型按字段传输，各字段通过序列化器的具体类型继续分派
+     */
+    template <class TValue>
+        requires requires { TypeID<TValue>::value; }
+    struct SerializerTransfer<TValue>
+    {
+        template <class TSerializer>
+        static void Invoke(TSerializer& serializer, TValue& value)
+        {
+            TypeTransfer<TValue, TSerializer>::Invoke(serializer, value);
+        }
+    };
+
+    struct Type;
+    /**
+     * 类型的注册信息
+     *
+     * 静态初始化时只会将自身插入链表，不进行解析和分配。完整的类型信息和查找索引都在首次使用时才创建。
+     */
+    struct TypeRegistration
+    {
+        inline static constinit const TypeRegistration* head = nullptr;
+
+        uuids::uuid uuid;
+        const std::type_info* info;
+        const Type& (*getType)();
+        const TypeRegistration* next;
+
+        TypeRegistration(const uuids::uuid& uuid, const std::type_info& info, const Type& (*getType)())
+            : uuid(uuid), info(&info), getType(getType), next(head)
+        {
+            head = this;
+        }
+    };
+
     struct Type
     {
         using Construct = void (*)(void* address);
         using Serialize = void (*)(Serializer&, void*);
 
-        inline static std::vector<std::unique_ptr<Type>> allTypes = {};
-        inline static std::unordered_map<uuids::uuid, Type*> uuidToType = {};
-        inline static std::unordered_map<std::type_index, Type*> indexToType = {};
-
+        /**
+         * 获取类型信息，首次调用时才会创建
+         * @tparam T 需通过MakeType注册
+         * @return
+         */
         template <typename T>
-        static Type& Register(const char* uuidStr)
+        static const Type& GetType()
         {
-            std::unique_ptr<Type>& type = allTypes.emplace_back(new Type());
-            
-            uuids::uuid uuid = uuids::uuid::from_string(uuidStr).value_or(uuids::uuid());
-            uuidToType.insert({uuid, type.get()});
-            indexToType.insert({typeid(T), type.get()});
-
-            type->uuid = uuid;
-            type->info = &typeid(T);
-            type->size = sizeof(T);
-            type->construct = TypeConstruct<T>::Invoke;
-            type->serialize = [](Serializer& serializer, void* ptr) { TypeTransfer<T, Serializer>::Invoke(serializer, *static_cast<T*>(ptr)); };
-            type->deserialize = type->serialize;
-
-            std::byte instance[sizeof(T)];
-            type->construct(instance);
-            MemberTransferrer memberTransferrer = {instance};
-            TypeTransfer<T, MemberTransferrer>::Invoke(memberTransferrer, *reinterpret_cast<T*>(instance));
-            type->fieldInfos.swap(memberTransferrer.GetResult());
-
-            return *type;
+            static const Type type = Create<T>();
+            return type;
+        }
+        /**
+         * 通过UUID查找类型，首次查找时才会建立索引
+         * @param uuid
+         * @return 未注册时返回nullptr
+         */
+        static const Type* GetType(const uuids::uuid& uuid)
+        {
+            const TypeRegistration* registration = FindRegistration([&uuid](const RegistrationIndex& index) -> const TypeRegistration*
+            {
+                auto it = index.uuidToRegistration.find(uuid);
+                return it == index.uuidToRegistration.end() ? nullptr : it->second;
+            });
+            return registration == nullptr ? nullptr : &registration->getType();
+        }
+        static const Type* GetType(const std::type_index type)
+        {
+            const TypeRegistration* registration = FindRegistration([&type](const RegistrationIndex& index) -> const TypeRegistration*
+            {
+                auto it = index.indexToRegistration.find(type);
+                return it == index.indexToRegistration.end() ? nullptr : it->second;
+            });
+            return registration == nullptr ? nullptr : &registration->getType();
         }
 
         uuids::uuid uuid;
@@ -79,6 +131,71 @@ namespace Light
         std::vector<FieldInfo> fieldInfos;
 
     private:
+        struct RegistrationIndex
+        {
+            const TypeRegistration* head = nullptr;
+            std::unordered_map<uuids::uuid, const TypeRegistration*> uuidToRegistration;
+            std::unordered_map<std::type_index, const TypeRegistration*> indexToRegistration;
+        };
+
+        static RegistrationIndex CreateIndex()
+        {
+            RegistrationIndex index;
+            index.head = TypeRegistration::head;
+            for (const TypeRegistration* registration = index.head; registration != nullptr; registration = registration->next)
+            {
+                index.uuidToRegistration.insert({registration->uuid, registration});
+                index.indexToRegistration.insert({*registration->info, registration});
+            }
+            return index;
+        }
+        /**
+         * 在索引上执行查找，索引过期时先重建
+         *
+         * 查找可能来自任务线程，因此查找持有共享锁，重建持有独占锁。
+         * 注册只发生在静态初始化期间，仅当此时就进行了查找，之后才可能需要重建。
+         */
+        template <class TFind>
+        static const TypeRegistration* FindRegistration(TFind&& find)
+        {
+            static RegistrationIndex index;
+            static std::shared_mutex indexMutex;
+
+            {
+                std::shared_lock lock(indexMutex);
+                if (index.head == TypeRegistration::head)
+                    return find(index);
+            }
+
+            std::unique_lock lock(indexMutex);
+            if (index.head != TypeRegistration::head)
+                index = CreateIndex();
+            return find(index);
+        }
+
+        template <typename T>
+        static Type Create()
+        {
+            Type type;
+            type.uuid = TypeID<T>::value;
+            type.info = &typeid(T);
+            type.size = sizeof(T);
+            type.construct = TypeConstruct<T>::Invoke;
+            //类型擦除的入口只能经过虚函数，已知序列化器的具体类型时应直接调用其Transfer
+            type.serialize = [](Serializer& serializer, void* ptr) { TypeTransfer<T, Serializer>::Invoke(serializer, *static_cast<T*>(ptr)); };
+            type.deserialize = type.serialize;
+
+            //字段偏移需借助实例获取
+            alignas(T) std::byte instance[sizeof(T)];
+            type.construct(instance);
+            MemberTransferrer memberTransferrer = {instance};
+            TypeTransfer<T, MemberTransferrer>::Invoke(memberTransferrer, *reinterpret_cast<T*>(instance));
+            type.fieldInfos.swap(memberTransferrer.GetResult());
+            std::destroy_at(reinterpret_cast<T*>(instance));
+
+            return type;
+        }
+
         class MemberTransferrer
         {
         public:
@@ -100,7 +217,9 @@ namespace Light
                     name,
                     typeid(TMember),
                     reinterpret_cast<std::byte*>(&value) - targetAddress,
-                    sizeof(TMember)
+                    sizeof(TMember),
+                    BitwiseTransferable<TMember>,
+                    [](Serializer& serializer, void* field) { serializer.Transfer(*static_cast<TMember*>(field)); }
                 );
             }
 
@@ -113,10 +232,13 @@ namespace Light
 
 #define MakeType_AddField(field) transferrer.TransferField(#field, value.field)
 #define MakeType(uuidStr,type,...)\
-    inline const Light::Type& type##Type = Light::Type::Register<type>(uuidStr);\
+    template <>\
+    struct Light::TypeID<type>\
+    {constexpr static uuids::uuid value = uuids::uuid::from_string(uuidStr).value();};\
     template <Light::Transferrer TTransferrer>\
     struct Light::TypeTransfer<type, TTransferrer>\
     {static void Invoke(TTransferrer& transferrer, type& value);};\
+    inline const Light::TypeRegistration type##Type = {Light::TypeID<type>::value, typeid(type), Light::Type::GetType<type>};\
     template <Light::Transferrer TTransferrer>\
     void Light::TypeTransfer<type,TTransferrer>::Invoke(TTransferrer& transferrer, type& value)
-}
+}
\ No newline at end of file
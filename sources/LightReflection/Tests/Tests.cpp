@@ -4,8 +4,10 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <typeindex>
 #include <gtest/gtest.h>
+#include <benchmark/benchmark.h>
 #include <ranges>
 
 #include "LightMath/Runtime/VectorMath.hpp"
@@ -13,6 +15,11 @@
 #include "LightReflection/Runtime/Type.hpp"
 #include "LightReflection/Runtime/Serialization/BinaryReader.h"
 #include "LightReflection/Runtime/Serialization/BinaryWriter.h"
+#include "LightReflection/Runtime/Serialization/Compression.h"
+#include "LightReflection/Runtime/Serialization/MappedBinaryReader.h"
+#include "LightReflection/Runtime/Serialization/SchemaBinaryReader.h"
+#include "LightReflection/Runtime/Serialization/SchemaBinaryWriter.h"
+#include "LightReflection/Runtime/Serialization/VectorTransfer.hpp"
 
 using namespace Light;
 
@@ -38,15 +45,129 @@ struct Data
     }
 };
 
-template <class Type, int Number>
-struct SerializerTransfer<vector<Type, Number>>
+std::vector<float3> MakeVertices(const int count)
 {
-    static void Invoke(Serializer& transferrer, vector<Type, Number>& value)
+    std::vector<float3> vertices(count);
+    for (int i = 0; i < count; i++)
+        vertices[i] = {static_cast<float>(i), static_cast<float>(i) * 0.5f, -static_cast<float>(i)};
+    return vertices;
+}
+bool EqualVertices(const std::vector<float3>& a, const std::vector<float3>& b)
+{
+    return std::ranges::equal(a, b, [](const float3& x, const float3& y) { return all(x == y); });
+}
+
+TEST(Reflection, BitwiseTransfer)
+{
+    std::vector<float3> oldVertices = MakeVertices(1000);
+    std::vector<int> oldIndices = {0, 1, 2, 2, 1, 3};
+
+    std::stringstream stream;
+    BinaryWriter writer = {stream};
+    writer.TransferField("vertices", oldVertices);
+    writer.TransferField("indices", oldIndices);
+    ASSERT_EQ(stream.str().size(), sizeof(int) + 1000 * sizeof(float3) + sizeof(int) + 6 * sizeof(int));
+
+    //整块传输的数据应与经过虚函数逐个传输的结果完全一致
+    std::stringstream virtualStream;
+    BinaryWriter virtualWriter = {virtualStream};
+    Serializer& serializer = virtualWriter;
+    serializer.TransferField("vertices", oldVertices);
+    serializer.TransferField("indices", oldIndices);
+    ASSERT_EQ(stream.str(), virtualStream.str());
+
+    BinaryReader reader = {stream};
+    std::vector<float3> newVertices;
+    std::vector<int> newIndices;
+    reader.TransferField("vertices", newVertices);
+    reader.TransferField("indices", newIndices);
+    ASSERT_TRUE(EqualVertices(newVertices, oldVertices));
+    ASSERT_EQ(newIndices, oldIndices);
+
+    BinaryReader virtualReader = {virtualStream};
+    Serializer& deserializer = virtualReader;
+    newVertices.clear();
+    deserializer.TransferField("vertices", newVertices);
+    ASSERT_TRUE(EqualVertices(newVertices, oldVertices));
+}
+
+TEST(Reflection, MappedBinaryReader)
+{
+    std::vector<float3> oldVertices = MakeVertices(1000);
+    std::vector<std::byte> oldBlob(4096, std::byte{7});
+    std::string oldName = "Mesh";
     {
-        for (int i = 0; i < Number; i++)
-            transferrer.Transfer(value.data[i]);
+        std::ofstream outStream("mapped.bin", std::ios::binary);
+        BinaryWriter writer = {outStream};
+        writer.TransferField("name", oldName);
+        writer.TransferField("vertices", oldVertices);
+        writer.TransferField("blob", oldBlob);
     }
-};
+
+    MappedFile file("mapped.bin");
+    MappedBinaryReader reader = {file};
+    std::string newName;
+    reader.TransferField("name", newName);
+    ASSERT_EQ(newName, oldName);
+    //"Mesh"后数组的起始地址恰好4字节对齐，可以直接创建视图
+    std::span<const float3> vertices = reader.ReadView<float3>();
+    ASSERT_TRUE(std::ranges::equal(vertices, oldVertices, [](const float3& x, const float3& y) { return all(x == y); }));
+    std::span<const std::byte> blob = reader.ReadView<std::byte>();
+    ASSERT_EQ(blob.data(), file.GetData().data() + file.GetData().size() - 4096);
+    ASSERT_TRUE(std::ranges::equal(blob, oldBlob));
+    ASSERT_EQ(reader.GetRemainingSize(), 0);
+    ASSERT_THROW(reader.ReadView<std::byte>(), std::runtime_error);
+
+    //虚函数路径同样可用
+    MappedBinaryReader virtualReader = {file};
+    Serializer& deserializer = virtualReader;
+    deserializer.TransferField("name", newName);
+    std::vector<float3> newVertices;
+    deserializer.TransferField("vertices", newVertices);
+    std::vector<std::byte> newBlob;
+    deserializer.TransferField("blob", newBlob);
+    ASSERT_TRUE(EqualVertices(newVertices, oldVertices));
+    ASSERT_EQ(newBlob, oldBlob);
+
+    //截断的数据在读取时应当报错而不是越界访问
+    MappedBinaryReader truncatedReader = {file.GetData().first(100)};
+    truncatedReader.TransferField("name", newName);
+    ASSERT_THROW(truncatedReader.TransferField("vertices", newVertices), std::runtime_error);
+}
+
+TEST(Reflection, SerializationBenchmark)
+{
+    constexpr int VertexCount = 1000000;
+
+    benchmark::RegisterBenchmark("Serialize/Virtual", [](benchmark::State& state)
+    {
+        std::vector<float3> vertices = MakeVertices(VertexCount);
+        for (auto _ : state)
+        {
+            std::stringstream stream;
+            BinaryWriter writer = {stream};
+            Serializer& serializer = writer;
+            serializer.TransferField("vertices", vertices);
+            benchmark::DoNotOptimize(stream);
+        }
+        state.SetItemsProcessed(state.iterations() * VertexCount);
+    });
+    benchmark::RegisterBenchmark("Serialize/Bitwise", [](benchmark::State& state)
+    {
+        std::vector<float3> vertices = MakeVertices(VertexCount);
+        for (auto _ : state)
+        {
+            std::stringstream stream;
+            BinaryWriter writer = {stream};
+            writer.TransferField("vertices", vertices);
+            benchmark::DoNotOptimize(stream);
+        }
+        state.SetItemsProcessed(state.iterations() * VertexCount);
+    });
+
+    benchmark::Initialize(nullptr, nullptr);
+    benchmark::RunSpecifiedBenchmarks();
+}
 
 TEST(Reflection, BinaryTransferrer)
 {
@@ -91,7 +212,25 @@ MakeType("C4BAB34E-B145-4297-8BA3-6DD1BD05110D", Data)
 TEST(Reflection, Type)
 {
     uuids::uuid uuid = uuids::uuid::from_string("C4BAB34E-B145-4297-8BA3-6DD1BD05110D").value();
-    Type* type = Type::uuidToType[uuid];
+    const Type* type = Type::GetType(uuid);
+    ASSERT_EQ(type, &Type::GetType<Data>());
+    ASSERT_EQ(type, Type::GetType(typeid(Data)));
+    ASSERT_EQ(Type::GetType(uuids::uuid()), nullptr);
+    ASSERT_EQ(TypeID<Data>::value, uuid);
+
+    //多个线程同时查找
+    std::atomic<int> foundCount = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.emplace_back([&]
+        {
+            for (int j = 0; j < 1000; j++)
+                if (Type::GetType(uuid) == type && Type::GetType(typeid(Data)) == type)
+                    foundCount.fetch_add(1, std::memory_order_relaxed);
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+    ASSERT_EQ(foundCount, 4000);
 
     std::cout << type->info->name() << '\n';
     for (auto& fieldInfo : type->fieldInfos)
@@ -102,3 +241,216 @@ TEST(Reflection, Type)
         std::cout << fieldInfo.size << '\n';
     }
 }
+
+//模拟Data修改后的版本：调整了字段顺序，删除了部分字段，并新增了字段
+struct DataV2
+{
+    float3 customValue;
+    std::string stringValue;
+    int intValue;
+    double addedValue = 42;
+};
+
+MakeType("0F6A2C71-2B5E-4C38-9A4D-7E1B3C5D8F20", DataV2)
+{
+    MakeType_AddField(customValue);
+    MakeType_AddField(stringValue);
+    MakeType_AddField(intValue);
+    MakeType_AddField(addedValue);
+}
+
+//嵌套了其他反射类型的网格资源
+struct MeshAsset
+{
+    std::string name;
+    std::vector<float3> vertices;
+    std::vector<int> indices;
+    Data data;
+};
+
+MakeType("5D3E8B1A-7C24-4F69-B0E2-91A6C8F4D273", MeshAsset)
+{
+    MakeType_AddField(name);
+    MakeType_AddField(vertices);
+    MakeType_AddField(indices);
+    MakeType_AddField(data);
+}
+
+TEST(Reflection, ReflectedTransfer)
+{
+    MeshAsset oldMesh = {"Mesh", MakeVertices(1000), {0, 1, 2, 2, 1, 3}, {true, 'A', 1, 0.5f, "Hello World!", {false, true}, {1, 2, 3}}};
+
+    //反射类型的各字段按序列化器的具体类型分派，顶点数组整块写入
+    std::stringstream stream;
+    BinaryWriter writer = {stream};
+    writer.Transfer(oldMesh);
+
+    //结果应与经过类型擦除入口逐个传输的结果完全一致
+    std::stringstream virtualStream;
+    BinaryWriter virtualWriter = {virtualStream};
+    Type::GetType<MeshAsset>().serialize(virtualWriter, &oldMesh);
+    ASSERT_EQ(stream.str(), virtualStream.str());
+
+    BinaryReader reader = {stream};
+    MeshAsset newMesh = {};
+    reader.Transfer(newMesh);
+    ASSERT_EQ(newMesh.name, oldMesh.name);
+    ASSERT_TRUE(EqualVertices(newMesh.vertices, oldMesh.vertices));
+    ASSERT_EQ(newMesh.indices, oldMesh.indices);
+    ASSERT_EQ(newMesh.data, oldMesh.data);
+
+    BinaryReader virtualReader = {virtualStream};
+    MeshAsset virtualMesh = {};
+    Type::GetType<MeshAsset>().serialize(virtualReader, &virtualMesh);
+    ASSERT_TRUE(EqualVertices(virtualMesh.vertices, oldMesh.vertices));
+    ASSERT_EQ(virtualMesh.data, oldMesh.data);
+}
+
+TEST(Reflection, SchemaBinary)
+{
+    Data oldData = {true, 'A', 1, 0.5f, "Hello World!", {false, true}, {1, 2, 3}};
+    std::stringstream stream;
+    SchemaBinaryWriter writer = {stream};
+    writer.Write(oldData);
+    writer.Write(oldData);
+    std::string bytes = stream.str();
+    std::span<const std::byte> data = {reinterpret_cast<const std::byte*>(bytes.data()), bytes.size()};
+
+    SchemaBinaryReader reader = {data};
+    ASSERT_EQ(reader.GetUUID(), DataType.uuid);
+    ASSERT_EQ(reader.GetFields().size(), Type::GetType<Data>().fieldInfos.size());
+    Data newData = {};
+    reader.Read(newData);
+    ASSERT_EQ(newData, oldData);
+
+    //多个对象依次存放
+    SchemaBinaryReader nextReader = {data.subspan(reader.GetSize())};
+    ASSERT_EQ(nextReader.GetSize() * 2, data.size());
+
+    //按名称匹配字段，不存在的字段保持原值
+    DataV2 newDataV2 = {};
+    newDataV2.intValue = 0;
+    reader.Read(newDataV2);
+    ASSERT_TRUE(all(newDataV2.customValue == oldData.customValue));
+    ASSERT_EQ(newDataV2.stringValue, oldData.stringValue);
+    ASSERT_EQ(newDataV2.intValue, oldData.intValue);
+    ASSERT_EQ(newDataV2.addedValue, 42);
+
+    //只读取需要的字段
+    std::string stringValue;
+    ASSERT_TRUE(reader.ReadField("stringValue", stringValue));
+    ASSERT_EQ(stringValue, oldData.stringValue);
+    float floatValue = 0;
+    ASSERT_TRUE(reader.ReadField("floatValue", floatValue));
+    ASSERT_EQ(floatValue, oldData.floatValue);
+    int wrongType = 0;
+    ASSERT_FALSE(reader.ReadField("floatValue", wrongType));
+    ASSERT_FALSE(reader.ReadField("missingValue", floatValue));
+
+    ASSERT_THROW(SchemaBinaryReader(data.first(10)), std::runtime_error);
+}
+
+//模拟组件数据：大量重复的结构中夹杂少量变化
+std::vector<std::byte> MakeCompressibleData(const size_t size)
+{
+    std::vector<std::byte> data(size);
+    uint32_t random = 1;
+    for (size_t i = 0; i < size; i++)
+    {
+        random = random * 1664525 + 1013904223;
+        data[i] = static_cast<std::byte>(i % 64 < 48 ? i % 16 : random >> 24);
+    }
+    return data;
+}
+
+TEST(Reflection, Compression)
+{
+    std::vector<std::byte> oldData = MakeCompressibleData(Compression::BlockSize * 5 + 1234);
+    for (CompressionLevel level : {CompressionLevel::Fast, CompressionLevel::Balanced})
+    {
+        std::vector<std::byte> compressed = Compression::Compress(oldData, level);
+        ASSERT_LT(compressed.size(), oldData.size() / 2);
+        ASSERT_EQ(Compression::GetBlocks(compressed).size(), 6);
+        ASSERT_EQ(Compression::Decompress(compressed), oldData);
+        ASSERT_EQ(Compression::Decompress(compressed, 4), oldData);
+    }
+
+    //难以压缩的数据按原样存储，极短的数据也能正确处理
+    std::vector<std::byte> randomData(10000);
+    uint32_t random = 7;
+    for (std::byte& value : randomData)
+    {
+        random = random * 1664525 + 1013904223;
+        value = static_cast<std::byte>(random >> 24);
+    }
+    std::vector<std::byte> compressedRandom = Compression::Compress(randomData);
+    ASSERT_TRUE(Compression::GetBlocks(compressedRandom)[0].isStored);
+    ASSERT_EQ(Compression::Decompress(compressedRandom), randomData);
+    for (size_t size : {0, 1, 12, 13, 100})
+    {
+        std::vector<std::byte> zeros(size);
+        ASSERT_EQ(Compression::Decompress(Compression::Compress(zeros)), zeros);
+    }
+
+    //损坏的数据应当报错而不是越界访问
+    std::vector<std::byte> corrupted = Compression::Compress(oldData);
+    corrupted.resize(corrupted.size() / 2);
+    ASSERT_THROW(Compression::Decompress(corrupted), std::runtime_error);
+
+    //经过流缓冲区与BinaryWriter和BinaryReader配合使用
+    std::vector<float3> oldVertices = MakeVertices(100000);
+    std::stringstream stream;
+    {
+        CompressionStreamBuffer buffer = {stream};
+        std::ostream compressedStream(&buffer);
+        BinaryWriter writer = {compressedStream};
+        writer.TransferField("vertices", oldVertices);
+        writer.TransferField("blob", oldData);
+    }
+    DecompressionStreamBuffer buffer = {stream};
+    std::istream decompressedStream(&buffer);
+    BinaryReader reader = {decompressedStream};
+    std::vector<float3> newVertices;
+    std::vector<std::byte> newData;
+    reader.TransferField("vertices", newVertices);
+    reader.TransferField("blob", newData);
+    ASSERT_TRUE(EqualVertices(newVertices, oldVertices));
+    ASSERT_EQ(newData, oldData);
+}
+
+TEST(Reflection, CompressionBenchmark)
+{
+    constexpr size_t DataSize = 16 * 1024 * 1024;
+
+    benchmark::RegisterBenchmark("Compression/Compress/Fast", [](benchmark::State& state)
+    {
+        std::vector<std::byte> data = MakeCompressibleData(DataSize);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Compression::Compress(data, CompressionLevel::Fast));
+        state.SetBytesProcessed(state.iterations() * DataSize);
+    });
+    benchmark::RegisterBenchmark("Compression/Compress/Balanced", [](benchmark::State& state)
+    {
+        std::vector<std::byte> data = MakeCompressibleData(DataSize);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Compression::Compress(data, CompressionLevel::Balanced));
+        state.SetBytesProcessed(state.iterations() * DataSize);
+    });
+    benchmark::RegisterBenchmark("Compression/Decompress", [](benchmark::State& state)
+    {
+        std::vector<std::byte> compressed = Compression::Compress(MakeCompressibleData(DataSize));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Compression::Decompress(compressed));
+        state.SetBytesProcessed(state.iterations() * DataSize);
+    });
+    benchmark::RegisterBenchmark("Compression/Decompress/4Threads", [](benchmark::State& state)
+    {
+        std::vector<std::byte> compressed = Compression::Compress(MakeCompressibleData(DataSize));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Compression::Decompress(compressed, 4));
+        state.SetBytesProcessed(state.iterations() * DataSize);
+    });
+
+    benchmark::Initialize(nullptr, nullptr);
+    benchmark::RunSpecifiedBenchmarks();
+}
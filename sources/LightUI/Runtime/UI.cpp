@@ -5,6 +5,7 @@
 #include <imgui_impl_vulkan.h>
 
 #include "LightGraphics/Runtime/SwapChain.h"
+#include "LightUtility/Runtime/Profiler.h"
 #include "LightWindow/Runtime/Input.h"
 #include "LightWindow/Runtime/Window.h"
 
@@ -79,6 +80,7 @@ namespace Light
     }
     void UI::EndFrame(GLCommandBuffer& commandBuffer)
     {
+        LIGHT_PROFILE_ZONE("UI::EndFrame");
         //生成绘制数据
         ImGui::Render();
         //提交绘制命令
@@ -0,0 +1,173 @@
+﻿#include "FileIO.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace Light
+{
+    FileIO& FileIO::GetDefault()
+    {
+        static FileIO fileIO = FileIO(2);
+        return fileIO;
+    }
+
+    std::vector<std::byte> FileIO::Read(const std::filesystem::path& path, std::vector<std::byte> buffer)
+    {
+        //通过ate标志初始就将读取位置设在流末尾，其位置即文件长度
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("文件打开失败！");
+        const std::streamsize fileSize = file.tellg();
+
+        buffer.resize(static_cast<size_t>(fileSize));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), fileSize))
+            throw std::runtime_error("文件读取失败！");
+        return buffer;
+    }
+    size_t FileIO::ReadRange(const std::filesystem::path& path, const uint64_t offset, const std::span<std::byte> destination)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("文件打开失败！");
+
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(destination.data()), static_cast<std::streamsize>(destination.size()));
+        if (file.bad())
+            throw std::runtime_error("文件读取失败！");
+        return static_cast<size_t>(file.gcount());
+    }
+    std::shared_ptr<MappedFile> FileIO::Map(const std::filesystem::path& path)
+    {
+        return std::make_shared<MappedFile>(path);
+    }
+
+    FileIO::FileIO(const int threadCount)
+    {
+        for (int i = 0; i < threadCount; i++)
+            threads.emplace_back([this] { RunThread(); });
+    }
+    FileIO::~FileIO()
+    {
+        {
+            std::lock_guard lock(requestMutex);
+            isStopping = true;
+        }
+        requestCondition.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::vector<std::byte> FileIO::AcquireBuffer()
+    {
+        std::lock_guard lock(bufferMutex);
+        if (pooledBuffers.empty())
+            return {};
+        std::vector<std::byte> buffer = std::move(pooledBuffers.back());
+        pooledBuffers.pop_back();
+        return buffer;
+    }
+    void FileIO::RecycleBuffer(std::vector<std::byte> buffer)
+    {
+        buffer.clear();
+        std::lock_guard lock(bufferMutex);
+        if (pooledBuffers.size() < MaxPooledBufferCount)
+            pooledBuffers.push_back(std::move(buffer));
+    }
+
+    void FileIO::ReadAsync(const std::filesystem::path& path, ReadCallback callback, std::vector<std::byte> buffer)
+    {
+        Submit([path,callback = std::move(callback),buffer = std::move(buffer)]() mutable
+        {
+            std::exception_ptr error;
+            try
+            {
+                buffer = Read(path, std::move(buffer));
+            }
+            catch (...)
+            {
+                //回调方可能忽略错误，因此在I/O线程上记录一次
+                LIGHT_LOG_WARNING(FileIOLog, "异步读取文件失败：{}", path.string());
+                error = std::current_exception();
+            }
+            callback(buffer, error);
+        });
+    }
+    std::future<std::vector<std::byte>> FileIO::ReadAsync(const std::filesystem::path& path, std::vector<std::byte> buffer)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<std::byte>>>();
+        std::future<std::vector<std::byte>> future = promise->get_future();
+        ReadAsync(path, [promise](std::vector<std::byte>& data, const std::exception_ptr& error)
+        {
+            if (error != nullptr)
+                promise->set_exception(error);
+            else
+                promise->set_value(std::move(data));
+        }, std::move(buffer));
+        return future;
+    }
+    void FileIO::ReadRangeAsync(const std::filesystem::path& path, const uint64_t offset, const std::span<std::byte> destination, ReadRangeCallback callback)
+    {
+        Submit([path,offset,destination,callback = std::move(callback)]
+        {
+            size_t readSize = 0;
+            std::exception_ptr error;
+            try
+            {
+                readSize = ReadRange(path, offset, destination);
+            }
+            catch (...)
+            {
+                LIGHT_LOG_WARNING(FileIOLog, "异步读取文件范围失败：{} offset:{}", path.string(), offset);
+                error = std::current_exception();
+            }
+            callback(readSize, error);
+        });
+    }
+    std::future<size_t> FileIO::ReadRangeAsync(const std::filesystem::path& path, const uint64_t offset, const std::span<std::byte> destination)
+    {
+        auto promise = std::make_shared<std::promise<size_t>>();
+        std::future<size_t> future = promise->get_future();
+        ReadRangeAsync(path, offset, destination, [promise](const size_t readSize, const std::exception_ptr& error)
+        {
+            if (error != nullptr)
+                promise->set_exception(error);
+            else
+                promise->set_value(readSize);
+        });
+        return future;
+    }
+
+    void FileIO::Submit(std::function<void()> request)
+    {
+        if (threads.empty())
+        {
+            //没有I/O线程时直接在调用线程上执行
+            request();
+            return;
+        }
+
+        {
+            std::lock_guard lock(requestMutex);
+            requests.push_back(std::move(request));
+        }
+        requestCondition.notify_one();
+    }
+    void FileIO::RunThread()
+    {
+        while (true)
+        {
+            std::function<void()> request;
+            {
+                std::unique_lock lock(requestMutex);
+                requestCondition.wait(lock, [this] { return isStopping || !requests.empty(); });
+                //停止前先处理完剩余的请求
+                if (requests.empty())
+                    break;
+                request = std::move(requests.front());
+                requests.pop_front();
+            }
+            request();
+        }
+    }
+}
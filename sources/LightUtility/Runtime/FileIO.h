@@ -0,0 +1,111 @@
+﻿#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Logger.h"
+#include "MappedFile.h"
+
+namespace Light
+{
+    inline LogModule FileIOLog = {"FileIO"};
+
+    /**
+     * 异步文件读取服务
+     *
+     * 读取请求进入队列，由专用的I/O线程依次执行，调用线程因此可以在读取期间继续解码或上传其他资源。
+     * 完成回调在I/O线程上执行，耗时的处理应转交给JobSystem，以免阻塞后续读取。
+     */
+    class FileIO
+    {
+    public:
+        using ReadCallback = std::function<void(std::vector<std::byte>& data, std::exception_ptr error)>;
+        using ReadRangeCallback = std::function<void(size_t readSize, std::exception_ptr error)>;
+
+        /**
+         * 全局共享的读取服务，使用两个I/O线程
+         * @return
+         */
+        static FileIO& GetDefault();
+
+        /**
+         * 同步读取整个文件，失败时抛出异常
+         * @param path
+         * @param buffer 用于存放结果的缓冲区，传入之前使用过的缓冲区可避免重新分配内存
+         * @return
+         */
+        static std::vector<std::byte> Read(const std::filesystem::path& path, std::vector<std::byte> buffer = {});
+        /**
+         * 同步读取文件的一部分，失败时抛出异常
+         * @param path
+         * @param offset 起始位置
+         * @param destination 读取到的位置，其长度即要读取的字节数
+         * @return 实际读取的字节数，到达文件末尾时会小于要求的字节数
+         */
+        static size_t ReadRange(const std::filesystem::path& path, uint64_t offset, std::span<std::byte> destination);
+        /**
+         * 将文件映射到内存，适合体积较大的只读文件，数据在访问时才按页载入
+         * @param path
+         * @return
+         */
+        static std::shared_ptr<MappedFile> Map(const std::filesystem::path& path);
+
+        /**
+         * @param threadCount I/O线程数
+         */
+        FileIO(int threadCount);
+        FileIO(const FileIO&) = delete;
+        /**
+         * 等待所有已提交的请求完成
+         */
+        ~FileIO();
+
+        /**
+         * 从缓冲区池中取出一个缓冲区，可作为读取的目标缓冲区，用完后通过RecycleBuffer归还，从而在多次读取间复用内存
+         * @return 池为空时返回空缓冲区
+         */
+        std::vector<std::byte> AcquireBuffer();
+        /**
+         * 归还缓冲区，池已满时直接释放
+         * @param buffer
+         */
+        void RecycleBuffer(std::vector<std::byte> buffer);
+
+        void ReadAsync(const std::filesystem::path& path, ReadCallback callback, std::vector<std::byte> buffer = {});
+        std::future<std::vector<std::byte>> ReadAsync(const std::filesystem::path& path, std::vector<std::byte> buffer = {});
+        /**
+         * @param path
+         * @param offset
+         * @param destination 在完成前需保持有效
+         * @param callback
+         */
+        void ReadRangeAsync(const std::filesystem::path& path, uint64_t offset, std::span<std::byte> destination, ReadRangeCallback callback);
+        std::future<size_t> ReadRangeAsync(const std::filesystem::path& path, uint64_t offset, std::span<std::byte> destination);
+
+        FileIO& operator=(const FileIO&) = delete;
+
+    private:
+        constexpr static int MaxPooledBufferCount = 8;
+
+        std::mutex bufferMutex;
+        std::vector<std::vector<std::byte>> pooledBuffers;
+
+        std::mutex requestMutex;
+        std::condition_variable requestCondition;
+        std::deque<std::function<void()>> requests;
+        bool isStopping = false;
+        std::vector<std::thread> threads;
+
+        void Submit(std::function<void()> request);
+        void RunThread();
+    };
+}
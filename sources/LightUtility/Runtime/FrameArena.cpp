@@ -0,0 +1,91 @@
+﻿#include "FrameArena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <numeric>
+
+namespace Light
+{
+    LinearArena::LinearArena(const size_t blockSize)
+    {
+        AddBlock(blockSize);
+    }
+
+    size_t LinearArena::GetUsedSize() const
+    {
+        return previousUsedSize + (current - blocks.back().memory.get());
+    }
+    size_t LinearArena::GetCapacity() const
+    {
+        return std::accumulate(blocks.begin(), blocks.end(), size_t{0}, [](const size_t sum, const Block& block) { return sum + block.size; });
+    }
+    int LinearArena::GetBlockCount() const
+    {
+        return static_cast<int>(blocks.size());
+    }
+
+    void* LinearArena::Allocate(const size_t size, const size_t alignment)
+    {
+        assert(std::has_single_bit(alignment) && "对齐值必须是2的幂！");
+        std::byte* address = reinterpret_cast<std::byte*>((reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(alignment - 1));
+        if (address + size > end)
+        {
+            //新块至少为上一块的两倍，并额外预留对齐所需的空间
+            previousUsedSize += current - blocks.back().memory.get();
+            AddBlock(std::max(blocks.back().size * 2, size + alignment));
+            address = reinterpret_cast<std::byte*>((reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(alignment - 1));
+        }
+
+        current = address + size;
+        return address;
+    }
+    void LinearArena::Reset()
+    {
+        //合并为一个块，使下次同样的用量只需一个块
+        if (blocks.size() > 1)
+        {
+            const size_t capacity = GetCapacity();
+            blocks.clear();
+            AddBlock(capacity);
+        }
+
+        current = blocks.back().memory.get();
+        previousUsedSize = 0;
+    }
+
+    void LinearArena::AddBlock(const size_t size)
+    {
+        Block& block = blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size), size);
+        current = block.memory.get();
+        end = current + size;
+    }
+
+    void* LinearArena::do_allocate(const size_t bytes, const size_t alignment)
+    {
+        return Allocate(bytes, alignment);
+    }
+
+    LinearArena& FrameArena::GetResource()
+    {
+        thread_local ThreadArenas threadArenas;
+
+        const uint64_t index = frameIndex.load(std::memory_order_relaxed);
+        const int bufferIndex = static_cast<int>(index % BufferCount);
+        if (threadArenas.frameIndices[bufferIndex] != index)
+        {
+            //该分配器上次使用是在至少BufferCount帧之前，其中的数据已失效
+            threadArenas.arenas[bufferIndex].Reset();
+            threadArenas.frameIndices[bufferIndex] = index;
+        }
+        return threadArenas.arenas[bufferIndex];
+    }
+    uint64_t FrameArena::GetFrameIndex()
+    {
+        return frameIndex.load(std::memory_order_relaxed);
+    }
+    void FrameArena::EndFrame()
+    {
+        frameIndex.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,113 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace Light
+{
+    /**
+     * 线性分配器，通过移动指针分配内存，不支持单独释放，只能整体重置
+     *
+     * 当前内存块不足时分配更大的新块。重置时若使用了多个块，会将它们合并为一个大小为总和的块，
+     * 因此每次重置间的用量稳定后不再向系统申请内存。
+     */
+    class LinearArena : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @param blockSize 首个内存块的大小
+         */
+        LinearArena(size_t blockSize = 64 * 1024);
+        LinearArena(const LinearArena&) = delete;
+
+        size_t GetUsedSize() const;
+        size_t GetCapacity() const;
+        int GetBlockCount() const;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        /**
+         * 分配并值初始化数组，由于分配器不会调用析构函数，元素类型需可平凡析构
+         * @param count
+         * @return
+         */
+        template <class TValue>
+        std::span<TValue> Allocate(const size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<TValue>, "线性分配器不会调用析构函数！");
+            TValue* values = static_cast<TValue*>(Allocate(count * sizeof(TValue), alignof(TValue)));
+            std::uninitialized_value_construct_n(values, count);
+            return {values, count};
+        }
+        /**
+         * 释放所有已分配的内存以供复用，之前分配的内存全部失效
+         */
+        void Reset();
+
+        LinearArena& operator=(const LinearArena&) = delete;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> memory;
+            size_t size;
+        };
+
+        std::vector<Block> blocks;
+        std::byte* current;
+        std::byte* end;
+        //之前已用完的块中的使用量
+        size_t previousUsedSize = 0;
+
+        void AddBlock(size_t size);
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override
+        {
+        }
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /**
+     * 每帧的临时内存，各线程使用各自的线性分配器，无需同步
+     *
+     * 每个线程有BufferCount个分配器轮流使用，因此某帧分配的内存会保留到下一帧结束，
+     * 可用于需要等待GPU使用完毕的数据（如提交的顶点和常量数据）。分配器在线程下次访问时才会延迟重置。
+     */
+    class FrameArena
+    {
+    public:
+        constexpr static int BufferCount = 2;
+
+        /**
+         * 获取当前线程当前帧的分配器，可直接用于std::pmr容器
+         * @return
+         */
+        static LinearArena& GetResource();
+        template <class TValue>
+        static std::span<TValue> Allocate(const size_t count)
+        {
+            return GetResource().Allocate<TValue>(count);
+        }
+
+        static uint64_t GetFrameIndex();
+        /**
+         * 结束当前帧，BufferCount帧前分配的内存在此后失效
+         */
+        static void EndFrame();
+
+    private:
+        struct ThreadArenas
+        {
+            LinearArena arenas[BufferCount];
+            uint64_t frameIndices[BufferCount] = {};
+        };
+
+        inline static std::atomic<uint64_t> frameIndex = 0;
+    };
+}
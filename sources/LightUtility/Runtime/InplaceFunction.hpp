@@ -0,0 +1,124 @@
+﻿#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Light
+{
+    template <class TSignature, size_t Capacity = 32>
+    class InplaceFunction;
+
+    /**
+     * 将可调用对象直接存放在内部缓冲区中的函数包装，用于替代热路径上的std::function
+     *
+     * 仅可移动，从不分配堆内存，可调用对象超出缓冲区大小时编译失败。
+     * 对于可平凡复制的可调用对象（如只捕获引用的lambda），移动和析构都不会产生间接调用。
+     * @tparam TResult
+     * @tparam TArgs
+     * @tparam Capacity 内部缓冲区的字节数
+     */
+    template <class TResult, class... TArgs, size_t Capacity>
+    class InplaceFunction<TResult(TArgs...), Capacity>
+    {
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t)
+        {
+        }
+        template <class TFunction> requires (!std::is_same_v<std::remove_cvref_t<TFunction>, InplaceFunction>
+            && std::is_invocable_r_v<TResult, std::decay_t<TFunction>&, TArgs...>)
+        InplaceFunction(TFunction&& function)
+        {
+            using Function = std::decay_t<TFunction>;
+            static_assert(sizeof(Function) <= Capacity, "可调用对象超出内联缓冲区的大小，请减少捕获或增大Capacity！");
+            static_assert(alignof(Function) <= alignof(std::max_align_t), "不支持该对齐要求的可调用对象！");
+            static_assert(std::is_nothrow_move_constructible_v<Function>, "可调用对象必须可无异常地移动！");
+
+            new(buffer) Function(std::forward<TFunction>(function));
+            invoker = [](void* object, TArgs&&... args) -> TResult
+            {
+                return std::invoke(*static_cast<Function*>(object), std::forward<TArgs>(args)...);
+            };
+            if constexpr (!std::is_trivially_copyable_v<Function> || !std::is_trivially_destructible_v<Function>)
+            {
+                manager = [](void* source, void* destination) noexcept
+                {
+                    Function& function = *static_cast<Function*>(source);
+                    if (destination != nullptr)
+                        new(destination) Function(std::move(function));
+                    function.~Function();
+                };
+            }
+        }
+        InplaceFunction(InplaceFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+        InplaceFunction(const InplaceFunction&) = delete;
+        ~InplaceFunction()
+        {
+            Reset();
+        }
+
+        explicit operator bool() const noexcept { return invoker != nullptr; }
+
+        TResult operator()(TArgs... args) const
+        {
+            assert(invoker != nullptr && "调用了空的函数！");
+            return invoker(buffer, std::forward<TArgs>(args)...);
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+        InplaceFunction& operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        friend bool operator==(const InplaceFunction& function, std::nullptr_t) noexcept { return function.invoker == nullptr; }
+
+    private:
+        using Invoker = TResult(*)(void* object, TArgs&&... args);
+        /**
+         * 目标为空时仅析构，否则将对象移动到目标后析构原对象。为空指针时表示对象可平凡复制和析构
+         */
+        using Manager = void(*)(void* source, void* destination) noexcept;
+
+        alignas(std::max_align_t) mutable std::byte buffer[Capacity];
+        Invoker invoker = nullptr;
+        Manager manager = nullptr;
+
+        void MoveFrom(InplaceFunction& other) noexcept
+        {
+            if (other.invoker == nullptr)
+                return;
+
+            if (other.manager == nullptr)
+                memcpy(buffer, other.buffer, Capacity);
+            else
+                other.manager(other.buffer, buffer);
+            invoker = std::exchange(other.invoker, nullptr);
+            manager = std::exchange(other.manager, nullptr);
+        }
+        void Reset() noexcept
+        {
+            if (manager != nullptr)
+                manager(buffer, nullptr);
+            invoker = nullptr;
+            manager = nullptr;
+        }
+    };
+}
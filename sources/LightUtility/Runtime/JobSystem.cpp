@@ -0,0 +1,341 @@
+﻿#include "JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Light
+{
+    struct JobHandle::Job
+    {
+        JobSystem::JobFunction task;
+        //未完成的依赖数，额外加一以防止在提交过程中被提前执行
+        std::atomic<int> dependencyCount;
+        std::mutex continuationMutex;
+        //依赖该任务的后续任务，它们在该任务完成前由自身的self保持存活
+        std::vector<Job*> continuations;
+        std::atomic<bool> isCompleted = false;
+        //在任务完成前保持存活，即便外部已不再持有句柄
+        std::shared_ptr<Job> self;
+    };
+
+    bool JobHandle::IsCompleted() const
+    {
+        assert(job != nullptr && "任务句柄无效！");
+        return job->isCompleted.load(std::memory_order_acquire);
+    }
+
+    /**
+     * 固定容量的Chase-Lev双端队列，所属线程在底部压入和弹出，其他线程从顶部窃取
+     */
+    class WorkStealingQueue
+    {
+    public:
+        constexpr static int64_t Capacity = 4096;
+
+        bool Push(JobHandle::Job* job)
+        {
+            const int64_t b = bottom.load(std::memory_order_relaxed);
+            const int64_t t = top.load(std::memory_order_acquire);
+            if (b - t >= Capacity)
+                return false;
+            buffer[b & (Capacity - 1)].store(job, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+        JobHandle::Job* Pop()
+        {
+            const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            JobHandle::Job* job = buffer[b & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                //只剩最后一个任务时与窃取者竞争
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+        JobHandle::Job* Steal()
+        {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return nullptr;
+
+            JobHandle::Job* job = buffer[t & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+
+    private:
+        //分开存放以避免所属线程和窃取者之间的伪共享
+        alignas(64) std::atomic<int64_t> top = 0;
+        alignas(64) std::atomic<int64_t> bottom = 0;
+        alignas(64) std::atomic<JobHandle::Job*> buffer[Capacity] = {};
+    };
+
+    struct JobSystem::Worker
+    {
+        JobSystem* system;
+        int index;
+        WorkStealingQueue queue;
+        std::thread thread;
+    };
+
+    JobSystem& JobSystem::GetDefault()
+    {
+        static JobSystem jobSystem = JobSystem(static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)) - 1);
+        return jobSystem;
+    }
+
+    JobSystem::JobSystem(const int threadCount)
+    {
+        assert(threadCount >= 0 && "线程数不能为负数！");
+        workers.reserve(threadCount);
+        for (int i = 0; i < threadCount; i++)
+        {
+            Worker& worker = *workers.emplace_back(std::make_unique<Worker>());
+            worker.system = this;
+            worker.index = i;
+        }
+        //所有工作线程的队列都创建后才能开始运行，因为它们会相互窃取
+        for (auto& worker : workers)
+            worker->thread = std::thread([this,worker = worker.get()] { RunWorker(*worker); });
+    }
+    JobSystem::~JobSystem()
+    {
+        WaitAll();
+
+        {
+            std::lock_guard lock(sleepMutex);
+            isStopping = true;
+        }
+        sleepCondition.notify_all();
+        for (auto& worker : workers)
+            worker->thread.join();
+    }
+
+    int JobSystem::GetThreadCount() const
+    {
+        return static_cast<int>(workers.size());
+    }
+
+    JobHandle JobSystem::Schedule(JobFunction task, const std::span<const JobHandle> dependencies)
+    {
+        std::shared_ptr<JobHandle::Job> job = std::make_shared<JobHandle::Job>();
+        job->task = std::move(task);
+        job->dependencyCount.store(static_cast<int>(dependencies.size()) + 1, std::memory_order_relaxed);
+        job->self = job;
+        unfinishedCount.fetch_add(1, std::memory_order_relaxed);
+
+        for (const JobHandle& dependency : dependencies)
+        {
+            bool isWaiting = false;
+            if (dependency.IsValid())
+            {
+                std::lock_guard lock(dependency.job->continuationMutex);
+                if (!dependency.job->isCompleted.load(std::memory_order_relaxed))
+                {
+                    dependency.job->continuations.push_back(job.get());
+                    isWaiting = true;
+                }
+            }
+            if (!isWaiting)
+                job->dependencyCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        Release(job.get());
+        return JobHandle(std::move(job));
+    }
+    JobHandle JobSystem::Schedule(JobFunction task, const std::initializer_list<JobHandle> dependencies)
+    {
+        return Schedule(std::move(task), std::span(dependencies.begin(), dependencies.size()));
+    }
+    JobHandle JobSystem::ContinueWith(const JobHandle& job, JobFunction continuation)
+    {
+        return Schedule(std::move(continuation), std::span(&job, 1));
+    }
+
+    void JobSystem::Wait(const JobHandle& job)
+    {
+        if (!job.IsValid())
+            return;
+
+        Worker* worker = GetCurrentWorker();
+        while (!job.job->isCompleted.load(std::memory_order_acquire))
+        {
+            if (JobHandle::Job* other = Dequeue(worker))
+            {
+                Execute(other);
+                continue;
+            }
+
+            //没有可执行的任务时休眠，直到任务完成或有新任务可以协助执行
+            std::unique_lock lock(sleepMutex);
+            waitingCount.fetch_add(1, std::memory_order_seq_cst);
+            waitCondition.wait(lock, [this,&job]
+            {
+                return job.job->isCompleted.load(std::memory_order_seq_cst) || queuedCount.load(std::memory_order_seq_cst) > 0;
+            });
+            waitingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    void JobSystem::WaitAll()
+    {
+        assert(executingCount == 0 && "不能在任务中等待所有任务完成！");
+
+        Worker* worker = GetCurrentWorker();
+        while (unfinishedCount.load(std::memory_order_acquire) != 0)
+        {
+            if (JobHandle::Job* job = Dequeue(worker))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            waitingCount.fetch_add(1, std::memory_order_seq_cst);
+            waitCondition.wait(lock, [this]
+            {
+                return unfinishedCount.load(std::memory_order_seq_cst) == 0 || queuedCount.load(std::memory_order_seq_cst) > 0;
+            });
+            waitingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    JobSystem::Worker* JobSystem::GetCurrentWorker() const
+    {
+        return currentWorker != nullptr && currentWorker->system == this ? currentWorker : nullptr;
+    }
+    void JobSystem::Enqueue(JobHandle::Job* job)
+    {
+        //工作线程提交的任务优先进入自身队列，队列已满或非工作线程提交时进入共享队列
+        Worker* worker = GetCurrentWorker();
+        if (worker == nullptr || !worker->queue.Push(job))
+        {
+            std::lock_guard lock(sharedQueueMutex);
+            sharedQueue.push_back(job);
+        }
+
+        queuedCount.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepingCount.load(std::memory_order_seq_cst) > 0)
+        {
+            //加锁以确保休眠线程要么尚未检查条件，要么已在等待通知
+            {
+                std::lock_guard lock(sleepMutex);
+            }
+            sleepCondition.notify_one();
+        }
+        NotifyWaiters();
+    }
+    JobHandle::Job* JobSystem::Dequeue(Worker* worker)
+    {
+        JobHandle::Job* job = nullptr;
+        if (worker != nullptr)
+            job = worker->queue.Pop();
+
+        if (job == nullptr)
+        {
+            std::lock_guard lock(sharedQueueMutex);
+            if (!sharedQueue.empty())
+            {
+                job = sharedQueue.front();
+                sharedQueue.pop_front();
+            }
+        }
+
+        if (job == nullptr && !workers.empty())
+        {
+            //从下一个工作线程开始依次尝试窃取，以分散竞争
+            const int workerCount = static_cast<int>(workers.size());
+            const int start = worker != nullptr ? worker->index + 1 : 0;
+            for (int i = 0; i < workerCount && job == nullptr; i++)
+            {
+                Worker& victim = *workers[(start + i) % workerCount];
+                if (&victim != worker)
+                    job = victim.queue.Steal();
+            }
+        }
+
+        if (job != nullptr)
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+    void JobSystem::Execute(JobHandle::Job* job)
+    {
+        executingCount++;
+        job->task();
+        job->task = nullptr;
+        executingCount--;
+
+        std::vector<JobHandle::Job*> continuations;
+        {
+            std::lock_guard lock(job->continuationMutex);
+            job->isCompleted.store(true, std::memory_order_release);
+            continuations.swap(job->continuations);
+        }
+        for (JobHandle::Job* continuation : continuations)
+            Release(continuation);
+
+        //释放自身引用，若外部也未持有句柄，任务在此销毁
+        job->self.reset();
+        unfinishedCount.fetch_sub(1, std::memory_order_acq_rel);
+        NotifyWaiters();
+    }
+    void JobSystem::NotifyWaiters()
+    {
+        //与等待线程增加waitingCount后检查条件的顺序相对应，保证二者至少有一方能看到对方的修改
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waitingCount.load(std::memory_order_relaxed) > 0)
+        {
+            {
+                std::lock_guard lock(sleepMutex);
+            }
+            waitCondition.notify_all();
+        }
+    }
+    void JobSystem::Release(JobHandle::Job* job)
+    {
+        if (job->dependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Enqueue(job);
+    }
+    void JobSystem::RunWorker(Worker& worker)
+    {
+        currentWorker = &worker;
+        while (true)
+        {
+            if (JobHandle::Job* job = Dequeue(&worker))
+            {
+                Execute(job);
+                continue;
+            }
+
+            //短暂让出后再尝试，仍没有任务时才休眠
+            std::this_thread::yield();
+            if (JobHandle::Job* job = Dequeue(&worker))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            sleepCondition.wait(lock, [this] { return isStopping || queuedCount.load(std::memory_order_seq_cst) > 0; });
+            sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+            if (isStopping)
+                break;
+        }
+        currentWorker = nullptr;
+    }
+}
@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "InplaceFunction.hpp"
+
+namespace Light
+{
+    class JobSystem;
+
+    /**
+     * 已提交任务的句柄，用于等待任务完成或作为其他任务的依赖
+     */
+    class JobHandle
+    {
+    public:
+        struct Job;
+
+        JobHandle() = default;
+
+        bool IsValid() const { return job != nullptr; }
+        bool IsCompleted() const;
+
+    private:
+        friend JobSystem;
+
+        std::shared_ptr<Job> job;
+
+        JobHandle(std::shared_ptr<Job> job): job(std::move(job))
+        {
+        }
+    };
+
+    /**
+     * 固定线程数的任务系统
+     *
+     * 每个工作线程有自己的任务队列，工作线程提交的任务进入自己的队列，空闲时从其他工作线程的队列末端窃取任务。
+     * 非工作线程提交的任务进入共享队列。等待任务的线程会协助执行其他任务，没有可执行的任务时才休眠。
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * 任务函数，捕获的数据需内联存放，不会分配堆内存
+         */
+        using JobFunction = InplaceFunction<void(), 64>;
+
+        /**
+         * 全局共享的任务系统，工作线程数为硬件线程数减一，剩余的一个由调用等待的线程协助
+         * @return
+         */
+        static JobSystem& GetDefault();
+
+        /**
+         * @param threadCount 工作线程数，为0时所有任务都在等待的线程上执行
+         */
+        JobSystem(int threadCount);
+        JobSystem(const JobSystem&) = delete;
+        ~JobSystem();
+
+        int GetThreadCount() const;
+
+        /**
+         * 提交任务，任务会在所有依赖完成后执行
+         * @param task
+         * @param dependencies
+         * @return
+         */
+        JobHandle Schedule(JobFunction task, std::span<const JobHandle> dependencies = {});
+        JobHandle Schedule(JobFunction task, std::initializer_list<JobHandle> dependencies);
+        /**
+         * 提交一个在指定任务完成后执行的后续任务
+         * @param job
+         * @param continuation
+         * @return
+         */
+        JobHandle ContinueWith(const JobHandle& job, JobFunction continuation);
+        /**
+         * 等待任务完成，等待期间协助执行其他任务，包括等待期间新提交的任务
+         * @param job
+         */
+        void Wait(const JobHandle& job);
+        /**
+         * 等待所有已提交的任务完成，等待期间协助执行其他任务
+         *
+         * 不能在任务中调用，因为正在执行的任务只有在等待结束后才能完成。
+         */
+        void WaitAll();
+
+        JobSystem& operator=(const JobSystem&) = delete;
+
+    private:
+        struct Worker;
+
+        //当前线程所属的工作线程，非工作线程为空
+        inline static thread_local Worker* currentWorker = nullptr;
+        //当前线程上正在执行的任务数，等待时协助执行的任务会嵌套
+        inline static thread_local int executingCount = 0;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::mutex sharedQueueMutex;
+        std::deque<JobHandle::Job*> sharedQueue;
+        //已进入队列但尚未取出的任务数，用于唤醒休眠的工作线程
+        std::atomic<int> queuedCount = 0;
+        //已提交但尚未完成的任务数，包括仍在等待依赖的任务
+        std::atomic<int> unfinishedCount = 0;
+        std::atomic<int> sleepingCount = 0;
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        bool isStopping = false;
+        //在Wait或WaitAll中休眠的线程，有新任务或任务完成时唤醒
+        std::atomic<int> waitingCount = 0;
+        std::condition_variable waitCondition;
+
+        Worker* GetCurrentWorker() const;
+        void Enqueue(JobHandle::Job* job);
+        JobHandle::Job* Dequeue(Worker* worker);
+        void Execute(JobHandle::Job* job);
+        void Release(JobHandle::Job* job);
+        void NotifyWaiters();
+        void RunWorker(Worker& worker);
+    };
+}
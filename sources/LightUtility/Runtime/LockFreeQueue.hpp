@@ -0,0 +1,246 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <span>
+
+namespace Light
+{
+    //缓存行大小，用于隔离不同线程频繁写入的数据以避免伪共享
+    constexpr size_t CacheLineSize = 64;
+
+    /**
+     * 有界的单生产者单消费者无锁队列
+     *
+     * 生产者和消费者各自缓存对方的位置，只有在缓存的位置显示队列已满或已空时才重新读取，从而减少跨核的缓存行传递。
+     * @tparam TValue 需可默认构造和移动赋值
+     */
+    template <class TValue>
+    class SPSCQueue
+    {
+    public:
+        /**
+         * @param capacity 会向上取整到2的幂
+         */
+        SPSCQueue(const size_t capacity)
+            : capacity(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(this->capacity - 1),
+              buffer(std::make_unique<TValue[]>(this->capacity))
+        {
+        }
+        SPSCQueue(const SPSCQueue&) = delete;
+
+        size_t GetCapacity() const { return capacity; }
+        /**
+         * 获取队列中的元素数，在其他线程同时操作时仅为近似值
+         * @return
+         */
+        size_t GetCount() const
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        /**
+         * 仅限生产者线程调用
+         * @param value
+         * @return 队列已满时返回false
+         */
+        bool TryPush(TValue value)
+        {
+            return TryPush(std::span(&value, 1)) == 1;
+        }
+        /**
+         * 批量压入，只需一次发布操作，仅限生产者线程调用
+         * @param values 成功压入的元素会被移走
+         * @return 实际压入的元素数
+         */
+        size_t TryPush(std::span<TValue> values)
+        {
+            const size_t currentTail = tail.load(std::memory_order_relaxed);
+            size_t freeCount = capacity - (currentTail - cachedHead);
+            if (freeCount < values.size())
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+                freeCount = capacity - (currentTail - cachedHead);
+            }
+
+            const size_t count = std::min(freeCount, values.size());
+            for (size_t i = 0; i < count; i++)
+                buffer[(currentTail + i) & mask] = std::move(values[i]);
+            tail.store(currentTail + count, std::memory_order_release);
+            return count;
+        }
+        /**
+         * 仅限消费者线程调用
+         * @param value
+         * @return 队列为空时返回false
+         */
+        bool TryPop(TValue& value)
+        {
+            return TryPop(std::span(&value, 1)) == 1;
+        }
+        /**
+         * 批量弹出，只需一次发布操作，仅限消费者线程调用
+         * @param values 弹出的元素依次写入其中
+         * @return 实际弹出的元素数
+         */
+        size_t TryPop(std::span<TValue> values)
+        {
+            const size_t currentHead = head.load(std::memory_order_relaxed);
+            size_t readyCount = cachedTail - currentHead;
+            if (readyCount < values.size())
+            {
+                cachedTail = tail.load(std::memory_order_acquire);
+                readyCount = cachedTail - currentHead;
+            }
+
+            const size_t count = std::min(readyCount, values.size());
+            for (size_t i = 0; i < count; i++)
+                values[i] = std::move(buffer[(currentHead + i) & mask]);
+            head.store(currentHead + count, std::memory_order_release);
+            return count;
+        }
+
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    private:
+        const size_t capacity;
+        const size_t mask;
+        const std::unique_ptr<TValue[]> buffer;
+
+        //消费者写入的数据
+        alignas(CacheLineSize) std::atomic<size_t> head = 0;
+        size_t cachedTail = 0;
+        //生产者写入的数据
+        alignas(CacheLineSize) std::atomic<size_t> tail = 0;
+        size_t cachedHead = 0;
+    };
+
+    /**
+     * 有界的多生产者多消费者无锁队列（Dmitry Vyukov的算法）
+     *
+     * 每个槽位带有序号，用于判断该槽位在当前轮次中是否可写入或读取，因此生产者和消费者只在各自的位置上竞争。
+     * @tparam TValue 需可默认构造和移动赋值
+     */
+    template <class TValue>
+    class MPMCQueue
+    {
+    public:
+        /**
+         * @param capacity 会向上取整到2的幂
+         */
+        MPMCQueue(const size_t capacity)
+            : capacity(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(this->capacity - 1),
+              cells(std::make_unique<Cell[]>(this->capacity))
+        {
+            for (size_t i = 0; i < this->capacity; i++)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        MPMCQueue(const MPMCQueue&) = delete;
+
+        size_t GetCapacity() const { return capacity; }
+
+        bool TryPush(TValue value)
+        {
+            return TryPush(std::span(&value, 1)) == 1;
+        }
+        /**
+         * 批量压入，一次性占用连续的可写入槽位
+         * @param values 成功压入的元素会被移走
+         * @return 实际压入的元素数
+         */
+        size_t TryPush(std::span<TValue> values)
+        {
+            if (values.empty())
+                return 0;
+
+            size_t position;
+            const size_t count = Acquire(enqueuePosition, values.size(), 0, position);
+            for (size_t i = 0; i < count; i++)
+            {
+                Cell& cell = cells[(position + i) & mask];
+                cell.value = std::move(values[i]);
+                cell.sequence.store(position + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+        bool TryPop(TValue& value)
+        {
+            return TryPop(std::span(&value, 1)) == 1;
+        }
+        /**
+         * 批量弹出，一次性占用连续的可读取槽位
+         * @param values 弹出的元素依次写入其中
+         * @return 实际弹出的元素数
+         */
+        size_t TryPop(std::span<TValue> values)
+        {
+            if (values.empty())
+                return 0;
+
+            size_t position;
+            const size_t count = Acquire(dequeuePosition, values.size(), 1, position);
+            for (size_t i = 0; i < count; i++)
+            {
+                Cell& cell = cells[(position + i) & mask];
+                values[i] = std::move(cell.value);
+                cell.sequence.store(position + i + capacity, std::memory_order_release);
+            }
+            return count;
+        }
+
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    private:
+        struct Cell
+        {
+            //等于位置时可写入，等于位置加一时可读取
+            std::atomic<size_t> sequence;
+            TValue value;
+        };
+
+        const size_t capacity;
+        const size_t mask;
+        const std::unique_ptr<Cell[]> cells;
+        alignas(CacheLineSize) std::atomic<size_t> enqueuePosition = 0;
+        alignas(CacheLineSize) std::atomic<size_t> dequeuePosition = 0;
+
+        /**
+         * 从position开始占用最多maxCount个就绪的连续槽位
+         * @param positionCounter 生产者或消费者的位置
+         * @param maxCount
+         * @param readyOffset 槽位就绪时其序号与位置之差
+         * @param position 占用的起始位置
+         * @return 占用的槽位数，为0表示队列已满或已空
+         */
+        size_t Acquire(std::atomic<size_t>& positionCounter, const size_t maxCount, const size_t readyOffset, size_t& position)
+        {
+            position = positionCounter.load(std::memory_order_relaxed);
+            while (true)
+            {
+                //统计从position开始连续就绪的槽位。已就绪的槽位在被他人占用前不会失效，而占用必然会使下面的比较交换失败
+                size_t count = 0;
+                bool isStale = false;
+                while (count < maxCount)
+                {
+                    const size_t sequence = cells[(position + count) & mask].sequence.load(std::memory_order_acquire);
+                    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + count + readyOffset);
+                    if (difference != 0)
+                    {
+                        //序号超前说明该槽位已被他人占用，position已过时
+                        isStale = count == 0 && difference > 0;
+                        break;
+                    }
+                    count++;
+                }
+
+                if (count == 0 && !isStale)
+                    return 0;
+                if (count != 0 && positionCounter.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                    return count;
+                if (isStale)
+                    position = positionCounter.load(std::memory_order_relaxed);
+            }
+        }
+    };
+}
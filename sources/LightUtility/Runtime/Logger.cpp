@@ -0,0 +1,548 @@
+﻿#include "Logger.h"
+
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "LockFreeQueue.hpp"
+#include "Profiler.h"
+
+namespace Light
+{
+    /**
+     * 格式化时引用记录中的一个参数
+     */
+    struct LogArgumentView
+    {
+        const LogRecord* record;
+        const LogArgument* argument;
+    };
+    /**
+     * 写入固定缓冲区的输出迭代器，超出容量的内容被丢弃，供崩溃时在不分配内存的情况下格式化
+     */
+    struct LogBufferIterator
+    {
+        using difference_type = std::ptrdiff_t;
+
+        char* position;
+        char* end;
+
+        LogBufferIterator& operator*() { return *this; }
+        LogBufferIterator& operator=(const char value)
+        {
+            if (position != end)
+                *position++ = value;
+            return *this;
+        }
+        LogBufferIterator& operator++() { return *this; }
+        LogBufferIterator& operator++(int) { return *this; }
+    };
+}
+
+/**
+ * 将格式说明原样转交给参数实际类型的格式化器
+ */
+template <>
+struct std::formatter<Light::LogArgumentView>
+{
+    std::string_view spec;
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context& context)
+    {
+        auto iterator = context.begin();
+        while (iterator != context.end() && *iterator != '}')
+            ++iterator;
+        spec = std::string_view(context.begin(), iterator);
+        return iterator;
+    }
+    std::format_context::iterator format(const Light::LogArgumentView& view, std::format_context& context) const
+    {
+        char format[32] = "{:";
+        const size_t specLength = std::min(spec.size(), sizeof(format) - 4);
+        std::copy_n(spec.data(), specLength, format + 2);
+        format[2 + specLength] = '}';
+        const std::string_view formatView(format, specLength + 3);
+
+        const Light::LogArgument& argument = *view.argument;
+        switch (argument.type)
+        {
+        case Light::LogArgumentType::Bool:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.boolValue));
+        case Light::LogArgumentType::Char:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.charValue));
+        case Light::LogArgumentType::Int:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.intValue));
+        case Light::LogArgumentType::UInt:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.uintValue));
+        case Light::LogArgumentType::Float:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.floatValue));
+        case Light::LogArgumentType::Double:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.doubleValue));
+        case Light::LogArgumentType::LongDouble:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.longDoubleValue));
+        case Light::LogArgumentType::Pointer:
+            return std::vformat_to(context.out(), formatView, std::make_format_args(argument.pointerValue));
+        case Light::LogArgumentType::Text:
+        default:
+            {
+                const std::string_view text(view.record->text + argument.textValue.offset, argument.textValue.length);
+                return std::vformat_to(context.out(), formatView, std::make_format_args(text));
+            }
+        }
+    }
+};
+
+namespace Light
+{
+    struct LogThread
+    {
+        constexpr static int QueueCapacity = 1024;
+
+        int index;
+        SPSCQueue<LogRecord> queue = {QueueCapacity};
+        //尚未报告的丢弃数量
+        std::atomic<size_t> droppedCount = 0;
+        //所属线程已退出，不会再写入队列
+        std::atomic<bool> isRetired = false;
+        //已退出且队列已排空，仅由收集线程访问
+        bool isDrained = false;
+    };
+
+    static void WriteDescriptor(const int descriptor, const char* data, size_t size)
+    {
+        while (size != 0)
+        {
+#ifdef _WIN32
+            const int written = _write(descriptor, data, static_cast<unsigned int>(size));
+#else
+            const ssize_t written = ::write(descriptor, data, size);
+#endif
+            if (written <= 0)
+                return;
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    /**
+     * 后台输出线程及其状态
+     */
+    class LogWriter
+    {
+    public:
+        //后台线程空闲时收集队列的间隔
+        constexpr static std::chrono::milliseconds CollectInterval = std::chrono::milliseconds(10);
+
+        std::mutex threadMutex;
+        std::vector<std::unique_ptr<LogThread>> threads;
+        int nextThreadIndex = 0;
+
+        LogWriter()
+        {
+            thread = std::thread([this] { Run(); });
+        }
+
+        /**
+         * 停止后台线程并输出剩余的日志，此后写入的日志由调用线程立即输出
+         */
+        void Stop()
+        {
+            {
+                std::lock_guard lock(wakeMutex);
+                if (isStopping)
+                    return;
+                isStopping = true;
+            }
+            wakeCondition.notify_one();
+            thread.join();
+            isStopped.store(true);
+            Collect();
+        }
+        bool IsStopped() const
+        {
+            return isStopped.load();
+        }
+
+        void Wake()
+        {
+            isWakeRequested.store(true, std::memory_order_relaxed);
+            wakeCondition.notify_one();
+        }
+        /**
+         * 收集所有队列中的记录并输出，同一时间只有一个线程能收集，从而保证每个队列只有一个消费者
+         */
+        void Collect()
+        {
+            std::lock_guard lock(collectMutex);
+            CollectLocked();
+        }
+        /**
+         * 崩溃时收集并输出，不分配内存，仅通过write输出到控制台和文件
+         *
+         * 崩溃可能发生在收集过程中或持有锁时，此时无法安全地收集，故只是尽力而为。
+         * @return 是否完成输出
+         */
+        bool TryCollectOnCrash()
+        {
+            bool isLocked = false;
+            for (int i = 0; i < 100 && !isLocked; i++)
+            {
+                isLocked = collectMutex.try_lock();
+                if (!isLocked)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (!isLocked)
+                return false;
+            std::lock_guard lock(collectMutex, std::adopt_lock);
+            if (!threadMutex.try_lock())
+                return false;
+            std::lock_guard threadLock(threadMutex, std::adopt_lock);
+
+            //预分配的缓冲区，崩溃时不能再分配内存。崩溃时各线程的记录依次输出，不再按时间交错
+            static LogRecord crashRecords[64];
+            static char crashBuffer[1024];
+            for (const auto& logThread : threads)
+            {
+                size_t count;
+                while ((count = logThread->queue.TryPop(std::span(crashRecords))) != 0)
+                {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        const LogBufferIterator end = FormatRecord(crashRecords[i], LogBufferIterator{crashBuffer, std::end(crashBuffer)});
+                        WriteCrashOutput(crashBuffer, static_cast<size_t>(end.position - crashBuffer));
+                    }
+                }
+            }
+            return true;
+        }
+
+        void SetConsoleOutput(const bool enable)
+        {
+            std::lock_guard lock(collectMutex);
+            isConsoleOutput = enable;
+        }
+        void SetFileOutput(const std::filesystem::path& path)
+        {
+            std::lock_guard lock(collectMutex);
+            CloseFile();
+            if (!path.empty())
+            {
+                //直接使用文件描述符，崩溃时才能不经过流缓冲区安全地写入
+#ifdef _WIN32
+                file = _wopen(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+                file = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+#endif
+                if (file < 0)
+                    throw std::runtime_error("无法打开日志文件！");
+            }
+        }
+
+    private:
+        std::thread thread;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::atomic<bool> isWakeRequested = false;
+        bool isStopping = false;
+        std::atomic<bool> isStopped = false;
+
+        std::mutex collectMutex;
+        std::vector<LogRecord> records;
+        std::vector<size_t> droppedCounts;
+        std::string output;
+        bool isConsoleOutput = true;
+        //日志文件的描述符，未打开时为-1
+        int file = -1;
+
+        void CloseFile()
+        {
+            if (file < 0)
+                return;
+#ifdef _WIN32
+            _close(file);
+#else
+            ::close(file);
+#endif
+            file = -1;
+        }
+        void WriteCrashOutput(const char* data, const size_t size) const
+        {
+            if (isConsoleOutput)
+                WriteDescriptor(1, data, size);
+            if (file >= 0)
+                WriteDescriptor(file, data, size);
+        }
+
+        void Run()
+        {
+            std::unique_lock lock(wakeMutex);
+            while (!isStopping)
+            {
+                wakeCondition.wait_for(lock, CollectInterval, [this]
+                {
+                    return isStopping || isWakeRequested.load(std::memory_order_relaxed);
+                });
+                isWakeRequested.store(false, std::memory_order_relaxed);
+
+                lock.unlock();
+                Collect();
+                lock.lock();
+            }
+        }
+        void CollectLocked()
+        {
+            std::vector<LogThread*> logThreads;
+            {
+                std::lock_guard lock(threadMutex);
+                for (auto& logThread : threads)
+                    logThreads.push_back(logThread.get());
+            }
+
+            records.clear();
+            LogRecord buffer[64];
+            for (LogThread* logThread : logThreads)
+            {
+                //须在排空前检查，此后线程不会再写入，排空后即可释放
+                const bool isRetired = logThread->isRetired.load(std::memory_order_acquire);
+                size_t count;
+                while ((count = logThread->queue.TryPop(std::span(buffer))) != 0)
+                    records.insert(records.end(), buffer, buffer + count);
+                logThread->isDrained = isRetired;
+            }
+            //各线程的记录按时间交错输出
+            std::ranges::stable_sort(records, std::less(), &LogRecord::timestamp);
+
+            output.clear();
+            for (const LogRecord& record : records)
+                FormatRecord(record, std::back_inserter(output));
+            for (LogThread* logThread : logThreads)
+            {
+                if (const size_t droppedCount = logThread->droppedCount.exchange(0, std::memory_order_relaxed); droppedCount != 0)
+                    std::format_to(std::back_inserter(output), "[Logger] 线程{}的日志队列已满，丢弃了{}条日志\n", logThread->index, droppedCount);
+            }
+            //释放已退出线程的队列
+            {
+                std::lock_guard lock(threadMutex);
+                std::erase_if(threads, [](const std::unique_ptr<LogThread>& logThread) { return logThread->isDrained; });
+            }
+            if (output.empty())
+                return;
+
+            if (isConsoleOutput)
+                std::cout.write(output.data(), static_cast<std::streamsize>(output.size())).flush();
+            if (file >= 0)
+                WriteDescriptor(file, output.data(), output.size());
+        }
+        template <class TOutput>
+        static TOutput FormatRecord(const LogRecord& record, TOutput output)
+        {
+            constexpr const char* levelNames[] = {"Trace", "Debug", "Info", "Warning", "Error", "Fatal", "Off"};
+            output = std::format_to(output, "[{:.6f}][{}][{}][{}] ",
+                                    static_cast<double>(record.timestamp) / 1e9, levelNames[static_cast<int>(record.level)], record.module, record.threadIndex);
+
+            LogArgumentView views[LogRecord::MaxArgumentCount];
+            for (int i = 0; i < LogRecord::MaxArgumentCount; i++)
+                views[i] = {&record, &record.arguments[i]};
+            try
+            {
+                output = std::vformat_to(output, record.format, std::make_format_args(
+                                             views[0], views[1], views[2], views[3], views[4], views[5], views[6], views[7]));
+            }
+            catch (const std::format_error&)
+            {
+                //保存的参数类型不支持该格式说明（如以{:p}输出字符串），改为输出格式字符串和各参数的默认格式
+                output = std::copy(record.format.begin(), record.format.end(), output);
+                for (int i = 0; i < record.argumentCount; i++)
+                    output = std::format_to(output, "{}{}", i == 0 ? " [" : ", ", views[i]);
+                if (record.argumentCount != 0)
+                    *output++ = ']';
+            }
+
+            if (record.level >= LogLevel::Warning)
+                output = std::format_to(output, " ({}:{})", record.file, record.line);
+            *output++ = '\n';
+            return output;
+        }
+    };
+
+    static LogWriter& GetLogWriter()
+    {
+        //有意不释放：其他静态对象的线程（如JobSystem、FileIO的工作线程）在其析构时才退出，
+        //退出前仍可能写入日志并标记自己的队列，因此只在程序退出时停止后台线程并排空队列
+        static LogWriter* writer = []
+        {
+            LogWriter* writer = new LogWriter();
+            std::atexit([] { GetLogWriter().Stop(); });
+            return writer;
+        }();
+        return *writer;
+    }
+    /**
+     * 线程退出时将其队列标记为已退出，由后台线程排空后释放
+     */
+    class LogThreadOwner
+    {
+    public:
+        LogThread* thread;
+
+        LogThreadOwner()
+        {
+            LogWriter& writer = GetLogWriter();
+            std::lock_guard lock(writer.threadMutex);
+            thread = writer.threads.emplace_back(std::make_unique<LogThread>()).get();
+            thread->index = writer.nextThreadIndex++;
+        }
+        ~LogThreadOwner()
+        {
+            thread->isRetired.store(true, std::memory_order_release);
+        }
+    };
+    static LogThread& GetLogThread()
+    {
+        thread_local LogThreadOwner owner;
+        return *owner.thread;
+    }
+    static std::atomic<size_t> droppedRecordCount = 0;
+
+    static std::mutex& GetModuleMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static std::vector<LogModule*>& GetModules()
+    {
+        //模块可能在其他编译单元的静态初始化期间注册，故使用局部静态变量
+        static std::vector<LogModule*> modules;
+        return modules;
+    }
+
+    LogModule::LogModule(const char* name, const LogLevel level)
+        : name(name), level(level)
+    {
+        std::lock_guard lock(GetModuleMutex());
+        GetModules().push_back(this);
+    }
+    LogModule::~LogModule()
+    {
+        std::lock_guard lock(GetModuleMutex());
+        std::erase(GetModules(), this);
+    }
+
+    void Logger::SetLevel(const LogLevel level)
+    {
+        std::lock_guard lock(GetModuleMutex());
+        for (LogModule* module : GetModules())
+            module->SetLevel(level);
+    }
+    bool Logger::SetLevel(const std::string_view module, const LogLevel level)
+    {
+        std::lock_guard lock(GetModuleMutex());
+        bool isFound = false;
+        for (LogModule* logModule : GetModules())
+        {
+            if (logModule->GetName() == module)
+            {
+                logModule->SetLevel(level);
+                isFound = true;
+            }
+        }
+        return isFound;
+    }
+    void Logger::SetConsoleOutput(const bool enable)
+    {
+        GetLogWriter().SetConsoleOutput(enable);
+    }
+    void Logger::SetFileOutput(const std::filesystem::path& path)
+    {
+        GetLogWriter().SetFileOutput(path);
+    }
+    void Logger::Flush()
+    {
+        GetLogWriter().Collect();
+    }
+
+    static std::terminate_handler previousTerminateHandler = nullptr;
+
+    static void HandleCrashSignal(const int signal)
+    {
+        Logger::FlushOnCrash();
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+#ifndef _WIN32
+    //信号处理使用的备用栈，使栈溢出导致的崩溃也能输出日志
+    alignas(16) static char crashSignalStack[64 * 1024];
+#endif
+    void Logger::InstallCrashHandler()
+    {
+        previousTerminateHandler = std::set_terminate([]
+        {
+            Logger::FlushOnCrash();
+            if (previousTerminateHandler != nullptr)
+                previousTerminateHandler();
+            std::abort();
+        });
+#ifdef _WIN32
+        for (const int signal : {SIGSEGV, SIGABRT, SIGFPE, SIGILL})
+            std::signal(signal, HandleCrashSignal);
+#else
+        //备用栈仅对调用线程生效
+        stack_t stack = {};
+        stack.ss_sp = crashSignalStack;
+        stack.ss_size = sizeof(crashSignalStack);
+        sigaltstack(&stack, nullptr);
+
+        struct sigaction action = {};
+        action.sa_handler = HandleCrashSignal;
+        action.sa_flags = SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        for (const int signal : {SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGBUS})
+            sigaction(signal, &action, nullptr);
+#endif
+    }
+    void Logger::FlushOnCrash()
+    {
+        static std::atomic<bool> isFlushing = false;
+        if (isFlushing.exchange(true))
+            return;
+        GetLogWriter().TryCollectOnCrash();
+    }
+
+    size_t Logger::GetDroppedRecordCount()
+    {
+        return droppedRecordCount.load(std::memory_order_relaxed);
+    }
+
+    void Logger::Submit(LogRecord& record)
+    {
+        LogThread& thread = GetLogThread();
+        record.timestamp = Profiler::GetTimestamp();
+        record.threadIndex = static_cast<uint16_t>(thread.index);
+        if (!thread.queue.TryPush(record))
+        {
+            thread.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            droppedRecordCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        LogWriter& writer = GetLogWriter();
+        if (record.level >= LogLevel::Fatal || writer.IsStopped())
+            writer.Collect();
+        else if (record.level >= LogLevel::Error)
+            writer.Wake();
+    }
+}
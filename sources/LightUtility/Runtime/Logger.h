@@ -0,0 +1,273 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * 记录日志，模块未启用该级别时不会对参数求值
+ * @param module LogModule对象
+ * @param level LogLevel
+ * @param ... 格式字符串（需为字面量）及其参数，格式同std::format
+ */
+#define LIGHT_LOG(module, level, ...) do { if ((module).IsEnabled(level)) ::Light::Logger::Write(module, level, __FILE__, __LINE__, __VA_ARGS__); } while (false)
+#define LIGHT_LOG_TRACE(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Trace, __VA_ARGS__)
+#define LIGHT_LOG_DEBUG(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Debug, __VA_ARGS__)
+#define LIGHT_LOG_INFO(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Info, __VA_ARGS__)
+#define LIGHT_LOG_WARNING(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Warning, __VA_ARGS__)
+#define LIGHT_LOG_ERROR(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Error, __VA_ARGS__)
+#define LIGHT_LOG_FATAL(module, ...) LIGHT_LOG(module, ::Light::LogLevel::Fatal, __VA_ARGS__)
+
+namespace Light
+{
+    enum class LogLevel : uint8_t
+    {
+        Trace,
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Fatal,
+        //仅用于关闭模块的日志
+        Off,
+    };
+
+    /**
+     * 日志所属的模块，各模块可单独设置最低的记录级别
+     *
+     * 应定义为全局对象，如inline LogModule ECSLog = {"ECS"};
+     */
+    class LogModule
+    {
+    public:
+        /**
+         * @param name 需为字符串字面量
+         * @param level
+         */
+        LogModule(const char* name, LogLevel level = LogLevel::Info);
+        LogModule(const LogModule&) = delete;
+        ~LogModule();
+
+        const char* GetName() const { return name; }
+        LogLevel GetLevel() const { return level.load(std::memory_order_relaxed); }
+        void SetLevel(const LogLevel level) { this->level.store(level, std::memory_order_relaxed); }
+        bool IsEnabled(const LogLevel level) const { return level >= GetLevel() && level != LogLevel::Off; }
+
+        LogModule& operator=(const LogModule&) = delete;
+
+    private:
+        const char* name;
+        std::atomic<LogLevel> level;
+    };
+    inline LogModule GeneralLog = {"General"};
+
+    enum class LogArgumentType : uint8_t
+    {
+        Bool,
+        Char,
+        Int,
+        UInt,
+        //浮点数按原精度保存，否则float转为double后会输出多余的位数
+        Float,
+        Double,
+        LongDouble,
+        Pointer,
+        //复制到记录的文本区中
+        Text,
+    };
+    struct LogTextRange
+    {
+        uint16_t offset;
+        uint16_t length;
+    };
+    struct LogArgument
+    {
+        LogArgumentType type;
+        union
+        {
+            bool boolValue;
+            char charValue;
+            int64_t intValue;
+            uint64_t uintValue;
+            float floatValue;
+            double doubleValue;
+            long double longDoubleValue;
+            const void* pointerValue;
+            LogTextRange textValue;
+        };
+    };
+    /**
+     * 二进制的日志记录，由调用线程写入，后台线程格式化
+     */
+    struct LogRecord
+    {
+        constexpr static int MaxArgumentCount = 8;
+        constexpr static int TextCapacity = 96;
+
+        //格式字符串为字面量，仅记录地址
+        std::string_view format;
+        const char* module;
+        const char* file;
+        uint64_t timestamp;
+        uint32_t line;
+        uint16_t threadIndex;
+        LogLevel level;
+        uint8_t argumentCount;
+        uint16_t textSize;
+        LogArgument arguments[MaxArgumentCount];
+        //超出容量的文本会被截断
+        char text[TextCapacity];
+    };
+
+    /**
+     * 异步日志
+     *
+     * 调用线程仅将格式字符串地址和参数写入自己的无锁环形队列，由后台线程统一格式化并输出到控制台或文件。
+     * 后台线程定期收集各队列，Error及以上级别会立即唤醒后台线程，Fatal级别会等待输出完成。
+     * 队列写满时新日志会被丢弃，丢弃数量会在之后输出。
+     * 程序退出时后台线程停止并输出剩余的日志，此后（如其他静态对象析构时）写入的日志由调用线程立即输出。
+     */
+    class Logger
+    {
+    public:
+        template <class... TArgs>
+        static void Write(const LogModule& module, const LogLevel level, const char* file, const int line,
+                          const std::format_string<TArgs...> format, TArgs&&... args)
+        {
+            static_assert(sizeof...(TArgs) <= LogRecord::MaxArgumentCount, "日志参数过多！");
+
+            LogRecord record;
+            record.format = format.get();
+            record.module = module.GetName();
+            record.file = file;
+            record.line = static_cast<uint32_t>(line);
+            record.level = level;
+            record.argumentCount = 0;
+            record.textSize = 0;
+            if constexpr ((IsDeferredArgument<std::remove_cvref_t<TArgs>> && ...))
+            {
+                (EncodeArgument(record, args), ...);
+            }
+            else
+            {
+                //含有无法延迟格式化的参数时，在调用线程上格式化整条消息，使格式说明作用于参数的原类型
+                const auto result = std::format_to_n(record.text, LogRecord::TextCapacity, format, args...);
+                record.format = "{}";
+                record.textSize = static_cast<uint16_t>(result.out - record.text);
+                LogArgument& argument = record.arguments[record.argumentCount++];
+                argument.type = LogArgumentType::Text;
+                argument.textValue = {0, record.textSize};
+            }
+            Submit(record);
+        }
+
+        /**
+         * 设置所有模块的最低记录级别
+         * @param level
+         */
+        static void SetLevel(LogLevel level);
+        /**
+         * 设置指定名称模块的最低记录级别
+         * @param module
+         * @param level
+         * @return 是否存在该模块
+         */
+        static bool SetLevel(std::string_view module, LogLevel level);
+        static void SetConsoleOutput(bool enable);
+        /**
+         * 将日志追加写入文件，传入空路径时关闭文件
+         * @param path
+         */
+        static void SetFileOutput(const std::filesystem::path& path);
+        /**
+         * 等待此前的所有日志输出完成
+         */
+        static void Flush();
+        /**
+         * 在程序崩溃（未捕获的异常、段错误、abort等）时尽量输出已记录的日志
+         *
+         * 崩溃时仅使用预分配的缓冲区和write输出，但格式化和加锁本身并非异步信号安全，因此只是尽力而为。
+         * 非Windows平台上信号在备用栈上处理，备用栈仅对调用该函数的线程生效。
+         */
+        static void InstallCrashHandler();
+        /**
+         * 立即输出已记录的日志，供崩溃时调用，不保证在崩溃状态下一定成功
+         */
+        static void FlushOnCrash();
+
+        static size_t GetDroppedRecordCount();
+
+    private:
+        /**
+         * 能否仅保存参数的值，由后台线程格式化
+         */
+        template <class T>
+        constexpr static bool IsDeferredArgument =
+            std::integral<T> || std::floating_point<T> || std::convertible_to<const T&, std::string_view> ||
+            std::is_pointer_v<T> || std::same_as<T, std::nullptr_t>;
+
+        static void Submit(LogRecord& record);
+
+        static void EncodeText(LogRecord& record, LogArgument& argument, std::string_view text)
+        {
+            argument.type = LogArgumentType::Text;
+            const size_t length = std::min(text.size(), static_cast<size_t>(LogRecord::TextCapacity - record.textSize));
+            std::copy_n(text.data(), length, record.text + record.textSize);
+            argument.textValue = {record.textSize, static_cast<uint16_t>(length)};
+            record.textSize += static_cast<uint16_t>(length);
+        }
+        template <class T>
+        static void EncodeArgument(LogRecord& record, const T& value)
+        {
+            LogArgument& argument = record.arguments[record.argumentCount++];
+            if constexpr (std::same_as<T, bool>)
+            {
+                argument.type = LogArgumentType::Bool;
+                argument.boolValue = value;
+            }
+            else if constexpr (std::same_as<T, char>)
+            {
+                argument.type = LogArgumentType::Char;
+                argument.charValue = value;
+            }
+            else if constexpr (std::signed_integral<T>)
+            {
+                argument.type = LogArgumentType::Int;
+                argument.intValue = value;
+            }
+            else if constexpr (std::unsigned_integral<T>)
+            {
+                argument.type = LogArgumentType::UInt;
+                argument.uintValue = value;
+            }
+            else if constexpr (std::same_as<T, float>)
+            {
+                argument.type = LogArgumentType::Float;
+                argument.floatValue = value;
+            }
+            else if constexpr (std::same_as<T, double>)
+            {
+                argument.type = LogArgumentType::Double;
+                argument.doubleValue = value;
+            }
+            else if constexpr (std::same_as<T, long double>)
+            {
+                argument.type = LogArgumentType::LongDouble;
+                argument.longDoubleValue = value;
+            }
+            else if constexpr (std::convertible_to<const T&, std::string_view>)
+            {
+                EncodeText(record, argument, std::string_view(value));
+            }
+            else
+            {
+                argument.type = LogArgumentType::Pointer;
+                argument.pointerValue = value;
+            }
+        }
+    };
+}
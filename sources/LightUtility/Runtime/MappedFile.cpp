@@ -0,0 +1,86 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Light
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("打开文件失败！");
+
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        //空文件无法创建映射，此时视为空数据
+        if (size == 0)
+            return;
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("创建文件映射失败！");
+        }
+        data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("映射文件失败！");
+        }
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file == -1)
+            throw std::runtime_error("打开文件失败！");
+
+        struct stat fileStat = {};
+        fstat(file, &fileStat);
+        size = static_cast<size_t>(fileStat.st_size);
+        //空文件无法创建映射，此时视为空数据
+        if (size != 0)
+        {
+            void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (address == MAP_FAILED)
+            {
+                close(file);
+                throw std::runtime_error("映射文件失败！");
+            }
+            data = static_cast<const std::byte*>(address);
+        }
+        //映射建立后即可关闭文件
+        close(file);
+#endif
+    }
+    MappedFile::~MappedFile()
+    {
+#ifdef _WIN32
+        if (data != nullptr)
+            UnmapViewOfFile(data);
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+#else
+        if (data != nullptr)
+            munmap(const_cast<std::byte*>(data), size);
+#endif
+    }
+
+    std::span<const std::byte> MappedFile::GetData() const
+    {
+        return {data, data == nullptr ? 0 : size};
+    }
+}
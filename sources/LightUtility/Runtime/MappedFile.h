@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Light
+{
+    /**
+     * 以只读方式映射到内存的文件
+     *
+     * 数据在首次访问时才由操作系统按页载入，适合读取体积较大的资源和快照。
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @param path 文件路径，打开失败时抛出异常
+         */
+        explicit MappedFile(const std::filesystem::path& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        std::span<const std::byte> GetData() const;
+
+    private:
+        const std::byte* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* file = nullptr;
+        void* mapping = nullptr;
+#endif
+    };
+}
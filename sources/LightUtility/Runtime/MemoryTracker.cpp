@@ -0,0 +1,136 @@
+﻿#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace Light
+{
+    struct CallSiteKey
+    {
+        MemoryTag tag;
+        std::string_view file; //源码位置中的文件名为静态字符串，可直接引用
+        uint32_t line;
+
+        friend bool operator==(const CallSiteKey&, const CallSiteKey&) = default;
+    };
+    struct CallSiteKeyHash
+    {
+        size_t operator()(const CallSiteKey& key) const noexcept
+        {
+            //同一文件在不同翻译单元或内联副本中的文件名地址可能不同，因此按内容比较
+            return std::hash<std::string_view>()(key.file) ^ key.line * 31 ^ static_cast<size_t>(key.tag) << 24;
+        }
+    };
+    struct CallSiteRecord
+    {
+        size_t allocationCount;
+        size_t allocatedBytes;
+    };
+
+    //各子系统内存用量的历史，仅由调用EndFrame的线程访问
+    static std::array<std::array<float, MemoryTracker::HistoryLength>, static_cast<int>(MemoryTag::Count)> histories = {};
+    static int historyIndex = 0;
+
+    static std::mutex callSiteMutex;
+    static std::unordered_map<CallSiteKey, CallSiteRecord, CallSiteKeyHash> callSites;
+
+    void MemoryTracker::EndFrame()
+    {
+        for (int i = 0; i < static_cast<int>(MemoryTag::Count); i++)
+        {
+            Counter& counter = counters[i];
+            counter.lastFrameAllocationCount.store(counter.frameAllocationCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            counter.lastFrameAllocatedBytes.store(counter.frameAllocatedBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            histories[i][historyIndex] = static_cast<float>(counter.currentBytes.load(std::memory_order_relaxed));
+        }
+        historyIndex = (historyIndex + 1) % HistoryLength;
+    }
+
+    const char* MemoryTracker::GetTagName(const MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General:
+            return "General";
+        case MemoryTag::ECS:
+            return "ECS";
+        case MemoryTag::Mesh:
+            return "Mesh";
+        case MemoryTag::ObjectPool:
+            return "ObjectPool";
+        case MemoryTag::GPUBuffer:
+            return "GPUBuffer";
+        case MemoryTag::GPUImage:
+            return "GPUImage";
+        default:
+            throw std::out_of_range("未知的内存标签！");
+        }
+    }
+    MemoryStatistics MemoryTracker::GetStatistics(const MemoryTag tag)
+    {
+        const Counter& counter = counters[static_cast<int>(tag)];
+        return {
+            counter.currentBytes.load(std::memory_order_relaxed),
+            counter.peakBytes.load(std::memory_order_relaxed),
+            counter.allocationCount.load(std::memory_order_relaxed),
+            counter.deallocationCount.load(std::memory_order_relaxed),
+            counter.lastFrameAllocationCount.load(std::memory_order_relaxed),
+            counter.lastFrameAllocatedBytes.load(std::memory_order_relaxed),
+        };
+    }
+    MemoryStatistics MemoryTracker::GetTotalStatistics()
+    {
+        MemoryStatistics total = {};
+        for (int i = 0; i < static_cast<int>(MemoryTag::Count); i++)
+        {
+            const MemoryStatistics statistics = GetStatistics(static_cast<MemoryTag>(i));
+            total.currentBytes += statistics.currentBytes;
+            total.peakBytes += statistics.peakBytes;
+            total.allocationCount += statistics.allocationCount;
+            total.deallocationCount += statistics.deallocationCount;
+            total.frameAllocationCount += statistics.frameAllocationCount;
+            total.frameAllocatedBytes += statistics.frameAllocatedBytes;
+        }
+        return total;
+    }
+    std::array<float, MemoryTracker::HistoryLength> MemoryTracker::GetHistory(const MemoryTag tag)
+    {
+        const std::array<float, HistoryLength>& history = histories[static_cast<int>(tag)];
+        std::array<float, HistoryLength> result;
+        std::ranges::rotate_copy(history, history.begin() + historyIndex, result.begin());
+        return result;
+    }
+
+    void MemoryTracker::SetCallSiteCapture(const bool enable)
+    {
+        std::lock_guard lock(callSiteMutex);
+        if (enable)
+            callSites.clear();
+        isCapturingCallSites.store(enable, std::memory_order_relaxed);
+    }
+    std::vector<MemoryCallSite> MemoryTracker::GetCallSites()
+    {
+        std::vector<MemoryCallSite> result;
+        {
+            std::lock_guard lock(callSiteMutex);
+            result.reserve(callSites.size());
+            for (const auto& [key, record] : callSites)
+                result.push_back({key.tag, std::string(key.file), key.line, record.allocationCount, record.allocatedBytes});
+        }
+        std::ranges::sort(result, std::greater(), &MemoryCallSite::allocatedBytes);
+        return result;
+    }
+    void MemoryTracker::RecordCallSite(const MemoryTag tag, const size_t size)
+    {
+        const CallSiteKey key = callSite != nullptr
+                                    ? CallSiteKey{tag, callSite->file_name(), callSite->line()}
+                                    : CallSiteKey{tag, "", 0};
+        std::lock_guard lock(callSiteMutex);
+        CallSiteRecord& record = callSites[key];
+        record.allocationCount++;
+        record.allocatedBytes += size;
+    }
+}
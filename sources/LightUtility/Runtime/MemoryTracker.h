@@ -0,0 +1,216 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace Light
+{
+    /**
+     * 内存所属的子系统
+     */
+    enum class MemoryTag : uint8_t
+    {
+        General,
+        ECS,
+        Mesh,
+        ObjectPool,
+        GPUBuffer,
+        GPUImage,
+        Count,
+    };
+
+    struct MemoryStatistics
+    {
+        size_t currentBytes;
+        size_t peakBytes;
+        size_t allocationCount;
+        size_t deallocationCount;
+        //上一帧内的分配次数和字节数，用于观察每帧的内存抖动
+        size_t frameAllocationCount;
+        size_t frameAllocatedBytes;
+    };
+    /**
+     * 调用点累计的分配量，未处于任何MemoryCallSiteScope中的分配记录为空文件名
+     */
+    struct MemoryCallSite
+    {
+        MemoryTag tag;
+        std::string file;
+        uint32_t line;
+        size_t allocationCount;
+        size_t allocatedBytes;
+    };
+
+    /**
+     * 按子系统统计内存的分配情况，包括当前和峰值用量、分配次数以及每帧的分配量
+     *
+     * 由各子系统在分配和释放时主动记录，统计只使用原子计数，开销很小。
+     * 开启调用点记录后，还会按当前线程的MemoryCallSiteScope累计分配量（需加锁），用于定位内存抖动的来源。
+     * 定义Light_MemoryTracker_Disable后，所有记录函数均为空。
+     */
+    class MemoryTracker
+    {
+    public:
+        constexpr static int HistoryLength = 120;
+
+        static void RecordAllocation(MemoryTag tag, size_t size)
+        {
+#ifndef Light_MemoryTracker_Disable
+            Counter& counter = counters[static_cast<int>(tag)];
+            const size_t currentBytes = counter.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+            size_t peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+            while (currentBytes > peakBytes && !counter.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+            {
+            }
+            counter.allocationCount.fetch_add(1, std::memory_order_relaxed);
+            counter.frameAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            counter.frameAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+            if (isCapturingCallSites.load(std::memory_order_relaxed))
+                RecordCallSite(tag, size);
+#endif
+        }
+        static void RecordDeallocation(MemoryTag tag, size_t size)
+        {
+#ifndef Light_MemoryTracker_Disable
+            Counter& counter = counters[static_cast<int>(tag)];
+            counter.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+            counter.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * 结束当前帧，保存本帧的分配量并记录各子系统内存用量的历史，应在主线程上每帧调用
+         */
+        static void EndFrame();
+
+        static const char* GetTagName(MemoryTag tag);
+        static MemoryStatistics GetStatistics(MemoryTag tag);
+        /**
+         * 获取所有子系统的合计，其中峰值为各子系统峰值之和
+         * @return
+         */
+        static MemoryStatistics GetTotalStatistics();
+        /**
+         * 获取最近HistoryLength帧结束时的内存用量，按时间从早到晚排列
+         * @param tag
+         * @return
+         */
+        static std::array<float, HistoryLength> GetHistory(MemoryTag tag);
+
+        static bool IsCapturingCallSites() { return isCapturingCallSites.load(std::memory_order_relaxed); }
+        /**
+         * 开启或关闭调用点记录，开启时丢弃之前记录的调用点
+         * @param enable
+         */
+        static void SetCallSiteCapture(bool enable);
+        /**
+         * 获取各调用点累计的分配量，按分配字节数从多到少排列
+         * @return
+         */
+        static std::vector<MemoryCallSite> GetCallSites();
+
+    private:
+        friend class MemoryCallSiteScope;
+
+        //原子类型默认初始化为零
+        struct alignas(64) Counter
+        {
+            std::atomic<size_t> currentBytes;
+            std::atomic<size_t> peakBytes;
+            std::atomic<size_t> allocationCount;
+            std::atomic<size_t> deallocationCount;
+            std::atomic<size_t> frameAllocationCount;
+            std::atomic<size_t> frameAllocatedBytes;
+            //仅由调用EndFrame的线程修改
+            std::atomic<size_t> lastFrameAllocationCount;
+            std::atomic<size_t> lastFrameAllocatedBytes;
+        };
+
+        inline static std::array<Counter, static_cast<int>(MemoryTag::Count)> counters = {};
+        inline static std::atomic<bool> isCapturingCallSites = false;
+        //当前线程最外层MemoryCallSiteScope的源码位置
+        inline static thread_local const std::source_location* callSite = nullptr;
+
+        static void RecordCallSite(MemoryTag tag, size_t size);
+    };
+
+    /**
+     * 在作用域内将当前线程的分配归属到指定的源码位置
+     *
+     * 子系统的公开接口通过默认参数获取调用者的位置并创建该对象，使内部的分配归属到用户代码。
+     * 嵌套时以最外层为准，因此也可在用户代码中创建，将一段代码中的所有分配归属到同一位置，
+     * 如通过std::make_unique等间接调用时，默认参数只能获取到间接调用处。
+     */
+    class MemoryCallSiteScope
+    {
+    public:
+        explicit MemoryCallSiteScope(const std::source_location location = std::source_location::current())
+            : location(location)
+        {
+#ifndef Light_MemoryTracker_Disable
+            if (MemoryTracker::callSite == nullptr)
+            {
+                MemoryTracker::callSite = &this->location;
+                isOutermost = true;
+            }
+#endif
+        }
+        MemoryCallSiteScope(const MemoryCallSiteScope&) = delete;
+        ~MemoryCallSiteScope()
+        {
+            if (isOutermost)
+                MemoryTracker::callSite = nullptr;
+        }
+
+        MemoryCallSiteScope& operator=(const MemoryCallSiteScope&) = delete;
+
+    private:
+        std::source_location location;
+        bool isOutermost = false;
+    };
+
+    /**
+     * 记录分配情况的标准库分配器，使容器的内存计入指定的子系统
+     */
+    template <class T, MemoryTag Tag>
+    class TrackedAllocator
+    {
+    public:
+        using value_type = T;
+
+        TrackedAllocator() = default;
+        template <class U>
+        TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept
+        {
+        }
+
+        T* allocate(const size_t count)
+        {
+            T* memory = std::allocator<T>().allocate(count);
+            MemoryTracker::RecordAllocation(Tag, count * sizeof(T));
+            return memory;
+        }
+        void deallocate(T* memory, const size_t count) noexcept
+        {
+            MemoryTracker::RecordDeallocation(Tag, count * sizeof(T));
+            std::allocator<T>().deallocate(memory, count);
+        }
+
+        template <class U>
+        struct rebind
+        {
+            using other = TrackedAllocator<U, Tag>;
+        };
+
+        template <class U>
+        friend bool operator==(const TrackedAllocator&, const TrackedAllocator<U, Tag>&) noexcept { return true; }
+    };
+
+    template <class T, MemoryTag Tag>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+}
@@ -1,60 +1,322 @@
 ﻿#pragma once
-#include <functional>
-#include <stack>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <memory>
-#include <stdexcept>
-#include <iostream>
+#include <mutex>
+#include <new>
+#include <source_location>
+#include <vector>
+
+#include "MemoryTracker.h"
 
 namespace Light
 {
+    enum class ObjectPoolThreading
+    {
+        //仅限单线程使用，没有同步开销
+        None,
+        //所有操作都通过互斥锁同步
+        Locked,
+        //每个线程有自己的对象缓存，大多数操作无需加锁，缓存为空或已满时才与共享的空闲链表批量交换
+        ThreadCache,
+    };
+
+    /**
+     * 为各线程分配对象池缓存的索引
+     *
+     * 线程退出时会将自身在各对象池中的缓存归还到共享链表，并回收索引供新线程使用，优先分配较小的索引。
+     */
+    class ObjectPoolThreadIndex
+    {
+    public:
+        using FlushFunction = void (*)(void* pool, int index);
+
+        static int Get()
+        {
+            thread_local const Owner owner;
+            return owner.index;
+        }
+
+        /**
+         * 登记使用线程缓存的对象池，线程退出时通过flush归还其缓存
+         * @param pool
+         * @param flush
+         */
+        static void Register(void* pool, const FlushFunction flush)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard lock(registry.mutex);
+            registry.pools.emplace_back(pool, flush);
+        }
+        static void Unregister(void* pool)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard lock(registry.mutex);
+            std::erase_if(registry.pools, [pool](const auto& item) { return item.first == pool; });
+        }
+
+    private:
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::pair<void*, FlushFunction>> pools;
+            std::vector<int> freeIndices;
+            int nextIndex = 0;
+        };
+        struct Owner
+        {
+            int index;
+
+            Owner()
+            {
+                Registry& registry = GetRegistry();
+                std::lock_guard lock(registry.mutex);
+                if (registry.freeIndices.empty())
+                {
+                    index = registry.nextIndex++;
+                }
+                else
+                {
+                    auto iterator = std::ranges::min_element(registry.freeIndices);
+                    index = *iterator;
+                    registry.freeIndices.erase(iterator);
+                }
+            }
+            ~Owner()
+            {
+                Registry& registry = GetRegistry();
+                std::lock_guard lock(registry.mutex);
+                for (const auto& [pool, flush] : registry.pools)
+                    flush(pool, index);
+                registry.freeIndices.push_back(index);
+            }
+        };
+
+        static Registry& GetRegistry()
+        {
+            //故意不析构，静态析构期间退出的线程仍需访问
+            static Registry* registry = new Registry();
+            return *registry;
+        }
+    };
+
+    /**
+     * 对象池，对象在归还后不会析构，下次获取时直接复用
+     *
+     * 对象以块为单位分配在连续内存中，空闲对象通过侵入式链表管理，对象本身只在首次被获取时构造。
+     * @tparam TObject
+     * @tparam Args 构造对象时使用的参数
+     */
     template <class TObject, auto... Args>
     class ObjectPool
     {
     public:
-        ObjectPool() = default;
+        ObjectPool(const ObjectPoolThreading threading = ObjectPoolThreading::None)
+            : threading(threading)
+        {
+            if (threading == ObjectPoolThreading::ThreadCache)
+            {
+                caches = std::make_unique<ThreadCache[]>(MaxThreadCacheCount);
+                ObjectPoolThreadIndex::Register(this, [](void* pool, const int index)
+                {
+                    static_cast<ObjectPool*>(pool)->FlushThreadCache(index);
+                });
+            }
+        }
         ObjectPool(const ObjectPool&) = delete;
-        ~ObjectPool() noexcept(false)
+        /**
+         * 若仍有对象未归还，则在调试时断言失败，并放弃回收内存以免这些对象失效
+         */
+        ~ObjectPool()
         {
+            if (caches != nullptr)
+                ObjectPoolThreadIndex::Unregister(this);
+
             if (GetUsableObjectsCount() != GetAllObjectsCount())
-                throw std::runtime_error("对象池开始销毁，但物体并没有全部归还！");
-            for (auto* object : managedObjectPool)
-                delete object;
+            {
+                assert(false && "对象池开始销毁，但物体并没有全部归还！");
+                for (auto& slab : slabs)
+                    static_cast<void>(slab.release());
+                return;
+            }
+
+            for (size_t i = 0; i < slabs.size(); i++)
+            {
+                const int count = i + 1 == slabs.size() ? lastSlabCount : SlabSize;
+                for (int j = 0; j < count; j++)
+                    slabs[i][j].GetObject().~TObject();
+                MemoryTracker::RecordDeallocation(MemoryTag::ObjectPool, sizeof(Slot) * SlabSize);
+            }
         }
 
+        /**
+         * 获取空闲对象数，在其他线程同时操作时仅为近似值
+         * @return
+         */
         size_t GetUsableObjectsCount()
         {
-            return usableObjectPool.size();
+            std::unique_lock lock = Lock();
+            size_t count = freeCount;
+            if (caches != nullptr)
+            {
+                for (int i = 0; i < MaxThreadCacheCount; i++)
+                    count += caches[i].count.load(std::memory_order_relaxed);
+            }
+            return count;
         }
         size_t GetAllObjectsCount()
         {
-            return managedObjectPool.size();
+            std::unique_lock lock = Lock();
+            return allCount;
         }
 
-        TObject& Get()
+        /**
+         * @param location 需要分配新块时，该分配归属的调用点
+         * @return
+         */
+        TObject& Get(const std::source_location location = std::source_location::current())
         {
-            TObject* object;
-            if (usableObjectPool.empty())
+            if (ThreadCache* cache = GetThreadCache())
             {
-                object = new TObject(Args...);
-                managedObjectPool.emplace_back(object);
-            }
-            else
-            {
-                object = usableObjectPool.top();
-                usableObjectPool.pop();
+                int count = cache->count.load(std::memory_order_relaxed);
+                if (count == 0)
+                {
+                    //从共享链表中批量取出一半容量，没有空闲对象时直接创建
+                    std::lock_guard lock(mutex);
+                    while (count < ThreadCacheCapacity / 2 && freeList != nullptr)
+                        cache->slots[count++] = PopFree();
+                    if (count == 0)
+                        return Create(location);
+                }
+                count--;
+                cache->count.store(count, std::memory_order_relaxed);
+                return cache->slots[count]->GetObject();
             }
 
-            return *object;
+            std::unique_lock lock = Lock();
+            if (freeList == nullptr)
+                return Create(location);
+            return PopFree()->GetObject();
         }
         void Release(TObject& element)
         {
-            usableObjectPool.push(&element);
+            //对象位于槽位起始处，因此可直接转换
+            Slot* slot = reinterpret_cast<Slot*>(&element);
+
+            if (ThreadCache* cache = GetThreadCache())
+            {
+                int count = cache->count.load(std::memory_order_relaxed);
+                if (count == ThreadCacheCapacity)
+                {
+                    //缓存已满时将一半归还到共享链表，使其他线程可以复用
+                    std::lock_guard lock(mutex);
+                    while (count > ThreadCacheCapacity / 2)
+                        PushFree(cache->slots[--count]);
+                }
+                cache->slots[count++] = slot;
+                cache->count.store(count, std::memory_order_relaxed);
+                return;
+            }
+
+            std::unique_lock lock = Lock();
+            PushFree(slot);
         }
 
-        ObjectPool& operator=(ObjectPool&&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
 
     private:
-        std::stack<TObject*> usableObjectPool;
-        std::vector<TObject*> managedObjectPool;
+        constexpr static int SlabSize = 64;
+        constexpr static int ThreadCacheCapacity = 32;
+        //超出该数量的线程不使用缓存，直接通过互斥锁访问共享链表
+        constexpr static int MaxThreadCacheCount = 64;
+
+        struct Slot
+        {
+            alignas(TObject) std::byte object[sizeof(TObject)];
+            Slot* next;
+
+            TObject& GetObject() { return *std::launder(reinterpret_cast<TObject*>(object)); }
+        };
+        struct alignas(64) ThreadCache
+        {
+            Slot* slots[ThreadCacheCapacity];
+            //仅由所属线程修改，其他线程只会在统计时读取
+            std::atomic<int> count = 0;
+        };
+
+        ObjectPoolThreading threading;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Slot[]>> slabs;
+        int lastSlabCount = SlabSize;
+        Slot* freeList = nullptr;
+        size_t freeCount = 0;
+        size_t allCount = 0;
+        std::unique_ptr<ThreadCache[]> caches;
+
+        std::unique_lock<std::mutex> Lock()
+        {
+            if (threading == ObjectPoolThreading::None)
+                return {};
+            return std::unique_lock(mutex);
+        }
+        ThreadCache* GetThreadCache()
+        {
+            if (caches == nullptr)
+                return nullptr;
+            const int index = ObjectPoolThreadIndex::Get();
+            return index < MaxThreadCacheCount ? &caches[index] : nullptr;
+        }
+        /**
+         * 将线程缓存全部归还到共享链表，由该线程退出时调用
+         * @param index
+         */
+        void FlushThreadCache(const int index)
+        {
+            if (index >= MaxThreadCacheCount)
+                return;
+
+            ThreadCache& cache = caches[index];
+            std::lock_guard lock(mutex);
+            int count = cache.count.load(std::memory_order_relaxed);
+            while (count > 0)
+                PushFree(cache.slots[--count]);
+            cache.count.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * 在当前块中构造新对象，块已用完时分配新块。调用时需已持有锁
+         * @return
+         */
+        TObject& Create(const std::source_location& location)
+        {
+            if (lastSlabCount == SlabSize)
+            {
+                MemoryCallSiteScope scope(location);
+                slabs.emplace_back(std::make_unique_for_overwrite<Slot[]>(SlabSize));
+                MemoryTracker::RecordAllocation(MemoryTag::ObjectPool, sizeof(Slot) * SlabSize);
+                lastSlabCount = 0;
+            }
+
+            Slot& slot = slabs.back()[lastSlabCount];
+            new(slot.object) TObject(Args...);
+            lastSlabCount++;
+            allCount++;
+            return slot.GetObject();
+        }
+        Slot* PopFree()
+        {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            freeCount--;
+            return slot;
+        }
+        void PushFree(Slot* slot)
+        {
+            slot->next = freeList;
+            freeList = slot;
+            freeCount++;
+        }
     };
 }
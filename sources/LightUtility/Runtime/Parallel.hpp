@@ -0,0 +1,282 @@
+﻿#pragma once
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace Light
+{
+    /**
+     * 基于JobSystem的数据并行算法
+     *
+     * 区间会被递归地二分，一半作为新任务提交，另一半由当前线程继续处理，直到不大于粒度。
+     * 空闲的工作线程会窃取这些任务，因此负载不均时也能自动平衡。粒度为0时根据工作线程数自动选择。
+     */
+    class Parallel
+    {
+    public:
+        /**
+         * 并行遍历区间[begin,end)
+         * @param begin
+         * @param end
+         * @param function 参数为单个索引，或子区间的起止索引(begin,end)
+         * @param grain 不再继续拆分的最大区间长度
+         */
+        template <class TFunction>
+        static void For(const int begin, const int end, const TFunction& function, const int grain = 0)
+        {
+            if (begin >= end)
+                return;
+
+            Split(begin, end, GetGrain(end - begin, grain), [&function](const int subBegin, const int subEnd)
+            {
+                if constexpr (std::is_invocable_v<const TFunction&, int, int>)
+                    function(subBegin, subEnd);
+                else
+                    for (int i = subBegin; i < subEnd; i++)
+                        function(i);
+            });
+        }
+
+        /**
+         * 并行归约区间[begin,end)，合并顺序与串行时相同，因此只要求合并操作满足结合律
+         * @param begin
+         * @param end
+         * @param identity 合并操作的单位元
+         * @param map 将单个索引映射为待合并的值
+         * @param combine 合并两个值
+         * @param grain
+         * @return
+         */
+        template <class TValue, class TMap, class TCombine>
+        static TValue Reduce(const int begin, const int end, const TValue& identity, const TMap& map, const TCombine& combine, const int grain = 0)
+        {
+            if (begin >= end)
+                return identity;
+
+            return ReduceRange(begin, end, GetGrain(end - begin, grain), identity, map, combine);
+        }
+
+        /**
+         * 并行归并排序，结果与std::stable_sort相同
+         * @param data
+         * @param compare
+         * @param grain
+         */
+        template <class TValue, class TCompare = std::less<>>
+        static void Sort(std::span<TValue> data, const TCompare& compare = {}, const int grain = 0)
+        {
+            const int size = static_cast<int>(data.size());
+            const int sortGrain = std::max(GetGrain(size, grain), 256);
+            if (size <= sortGrain)
+            {
+                std::stable_sort(data.begin(), data.end(), compare);
+                return;
+            }
+
+            std::vector<TValue> buffer(size);
+            SortRange(data.data(), buffer.data(), size, compare, sortGrain);
+        }
+
+        /**
+         * 并行前缀和，output[i]为input[0..i]的合并结果
+         * @param input
+         * @param output 可以与input相同
+         * @param identity
+         * @param combine 需满足结合律
+         * @param grain
+         */
+        template <class TValue, class TCombine = std::plus<>>
+        static void InclusiveScan(std::span<const std::type_identity_t<TValue>> input, std::span<TValue> output, const TValue& identity = {}, const TCombine& combine = {}, const int grain = 0)
+        {
+            ScanRange<true>(input, output, identity, combine, grain);
+        }
+        /**
+         * 并行前缀和，output[i]为input[0..i)的合并结果，常用于计算紧凑化时各元素的目标位置
+         * @param input
+         * @param output 可以与input相同
+         * @param identity
+         * @param combine 需满足结合律
+         * @param grain
+         * @return 所有元素的合并结果
+         */
+        template <class TValue, class TCombine = std::plus<>>
+        static TValue ExclusiveScan(std::span<const std::type_identity_t<TValue>> input, std::span<TValue> output, const TValue& identity = {}, const TCombine& combine = {}, const int grain = 0)
+        {
+            return ScanRange<false>(input, output, identity, combine, grain);
+        }
+
+    private:
+        static int GetGrain(const int size, const int grain)
+        {
+            if (grain > 0)
+                return grain;
+            //每个线程平均约8个区间，既便于窃取平衡负载，又不至于让调度开销过大
+            const int partCount = (JobSystem::GetDefault().GetThreadCount() + 1) * 8;
+            return std::max(1, (size + partCount - 1) / partCount);
+        }
+
+        template <class TFunction>
+        static void Split(int begin, int end, const int grain, const TFunction& function)
+        {
+            JobSystem& jobSystem = JobSystem::GetDefault();
+
+            //右半部分作为任务提交，左半部分继续拆分，最后由当前线程处理最左侧的区间
+            std::vector<JobHandle> jobs;
+            while (end - begin > grain)
+            {
+                const int middle = begin + (end - begin) / 2;
+                jobs.push_back(jobSystem.Schedule([middle,end,grain,&function]
+                {
+                    Split(middle, end, grain, function);
+                }));
+                end = middle;
+            }
+            function(begin, end);
+
+            for (auto job = jobs.rbegin(); job != jobs.rend(); ++job)
+                jobSystem.Wait(*job);
+        }
+
+        template <class TValue, class TMap, class TCombine>
+        static TValue ReduceRange(const int begin, const int end, const int grain, const TValue& identity, const TMap& map, const TCombine& combine)
+        {
+            if (end - begin <= grain)
+            {
+                TValue value = identity;
+                for (int i = begin; i < end; i++)
+                    value = combine(value, map(i));
+                return value;
+            }
+
+            JobSystem& jobSystem = JobSystem::GetDefault();
+            const int middle = begin + (end - begin) / 2;
+            TValue right;
+            JobHandle job = jobSystem.Schedule([&]
+            {
+                right = ReduceRange(middle, end, grain, identity, map, combine);
+            });
+            TValue left = ReduceRange(begin, middle, grain, identity, map, combine);
+            jobSystem.Wait(job);
+            return combine(left, right);
+        }
+
+        /**
+         * 将有序的[first,firstEnd)和[second,secondEnd)合并到output中。
+         * 取较长一段的中间元素，在另一段中二分查找其位置，从而将合并拆成两个独立的子问题
+         */
+        template <class TValue, class TCompare>
+        static void Merge(TValue* first, TValue* firstEnd, TValue* second, TValue* secondEnd, TValue* output, const TCompare& compare, const int grain)
+        {
+            const int firstSize = static_cast<int>(firstEnd - first);
+            const int secondSize = static_cast<int>(secondEnd - second);
+            if (firstSize + secondSize <= grain)
+            {
+                std::merge(std::make_move_iterator(first), std::make_move_iterator(firstEnd),
+                           std::make_move_iterator(second), std::make_move_iterator(secondEnd),
+                           output, compare);
+                return;
+            }
+
+            //为保持稳定性，第一段中相等的元素要排在第二段之前
+            TValue* firstMiddle;
+            TValue* secondMiddle;
+            if (firstSize >= secondSize)
+            {
+                firstMiddle = first + firstSize / 2;
+                secondMiddle = std::lower_bound(second, secondEnd, *firstMiddle, compare);
+            }
+            else
+            {
+                secondMiddle = second + secondSize / 2;
+                firstMiddle = std::upper_bound(first, firstEnd, *secondMiddle, compare);
+            }
+
+            TValue* outputMiddle = output + (firstMiddle - first) + (secondMiddle - second);
+            JobSystem& jobSystem = JobSystem::GetDefault();
+            JobHandle job = jobSystem.Schedule([=,&compare]
+            {
+                Merge(firstMiddle, firstEnd, secondMiddle, secondEnd, outputMiddle, compare, grain);
+            });
+            Merge(first, firstMiddle, second, secondMiddle, output, compare, grain);
+            jobSystem.Wait(job);
+        }
+        /**
+         * 对data排序，buffer为同样大小的临时空间
+         */
+        template <class TValue, class TCompare>
+        static void SortRange(TValue* data, TValue* buffer, const int size, const TCompare& compare, const int grain)
+        {
+            if (size <= grain)
+            {
+                std::stable_sort(data, data + size, compare);
+                return;
+            }
+
+            JobSystem& jobSystem = JobSystem::GetDefault();
+            const int middle = size / 2;
+            JobHandle job = jobSystem.Schedule([=,&compare]
+            {
+                SortRange(data + middle, buffer + middle, size - middle, compare, grain);
+            });
+            SortRange(data, buffer, middle, compare, grain);
+            jobSystem.Wait(job);
+
+            Merge(data, data + middle, data + middle, data + size, buffer, compare, grain);
+            For(0, size, [data,buffer](const int begin, const int end)
+            {
+                std::move(buffer + begin, buffer + end, data + begin);
+            }, grain);
+        }
+
+        /**
+         * 分三步：并行求各块的合并结果，串行求各块的起始值，再并行求各块内的前缀和
+         */
+        template <bool Inclusive, class TValue, class TCombine>
+        static TValue ScanRange(std::span<const TValue> input, std::span<TValue> output, const TValue& identity, const TCombine& combine, const int grain)
+        {
+            assert(input.size() == output.size() && "输入和输出的长度必须相同！");
+            const int size = static_cast<int>(input.size());
+            if (size == 0)
+                return identity;
+
+            const int blockSize = GetGrain(size, grain);
+            const int blockCount = (size + blockSize - 1) / blockSize;
+            std::vector<TValue> blockValues(blockCount);
+            For(0, blockCount, [&](const int block)
+            {
+                const int end = std::min(size, (block + 1) * blockSize);
+                TValue value = identity;
+                for (int i = block * blockSize; i < end; i++)
+                    value = combine(value, input[i]);
+                blockValues[block] = value;
+            }, 1);
+
+            TValue total = identity;
+            for (TValue& blockValue : blockValues)
+            {
+                TValue value = combine(total, blockValue);
+                blockValue = total;
+                total = value;
+            }
+
+            For(0, blockCount, [&](const int block)
+            {
+                const int end = std::min(size, (block + 1) * blockSize);
+                TValue value = blockValues[block];
+                for (int i = block * blockSize; i < end; i++)
+                {
+                    //先读取输入，以支持输入与输出相同的情况
+                    TValue next = combine(value, input[i]);
+                    output[i] = Inclusive ? next : value;
+                    value = next;
+                }
+            }, 1);
+
+            return total;
+        }
+    };
+}
@@ -0,0 +1,263 @@
+﻿#include "Profiler.h"
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "LockFreeQueue.hpp"
+
+namespace Light
+{
+    enum class ProfileEventType : uint8_t
+    {
+        Zone,
+        Counter,
+        Frame,
+    };
+
+    struct ProfileEvent
+    {
+        const char* name;
+        uint64_t time;
+        //区间事件为结束时间，计数器事件为数值
+        union
+        {
+            uint64_t endTime;
+            double value;
+        };
+        ProfileEventType type;
+        int threadIndex;
+    };
+
+    struct ProfileThread
+    {
+        //每帧都会收集，只需容纳一帧内的事件
+        constexpr static int QueueCapacity = 16 * 1024;
+
+        int index;
+        std::atomic<const char*> name = nullptr;
+        SPSCQueue<ProfileEvent> queue = {QueueCapacity};
+        std::atomic<size_t> droppedCount = 0;
+        //所属线程已退出，不会再写入队列
+        std::atomic<bool> isRetired = false;
+    };
+    struct RetiredProfileThread
+    {
+        int index;
+        const char* name;
+    };
+
+    //采集用数据，已退出线程的队列在收集后释放，仅保留其名称以便导出
+    static std::mutex profilerMutex;
+    static std::vector<std::unique_ptr<ProfileThread>> profileThreads;
+    static std::vector<RetiredProfileThread> retiredProfileThreads;
+    static size_t retiredDroppedCount = 0;
+    static int nextProfileThreadIndex = 0;
+    static std::vector<ProfileEvent> profileEvents;
+    static const std::chrono::steady_clock::time_point profileStartTime = std::chrono::steady_clock::now();
+
+    /**
+     * 线程退出时将其队列标记为已退出，由下次收集时释放
+     */
+    class ProfileThreadOwner
+    {
+    public:
+        ProfileThread* thread;
+
+        ProfileThreadOwner()
+        {
+            std::lock_guard lock(profilerMutex);
+            thread = profileThreads.emplace_back(std::make_unique<ProfileThread>()).get();
+            thread->index = nextProfileThreadIndex++;
+        }
+        ~ProfileThreadOwner()
+        {
+            thread->isRetired.store(true, std::memory_order_release);
+        }
+    };
+    static ProfileThread& GetProfileThread()
+    {
+        thread_local ProfileThreadOwner owner;
+        return *owner.thread;
+    }
+    static void PushProfileEvent(ProfileEvent event)
+    {
+        ProfileThread& thread = GetProfileThread();
+        event.threadIndex = thread.index;
+        if (!thread.queue.TryPush(event))
+            thread.droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    /**
+     * 将各线程队列中的事件转移到profileEvents中，调用时需已持有profilerMutex，从而保证每个队列只有一个消费者
+     */
+    static void CollectProfileEvents()
+    {
+        ProfileEvent events[256];
+        std::erase_if(profileThreads, [&events](const std::unique_ptr<ProfileThread>& thread)
+        {
+            //须在排空前检查，此后线程不会再写入，排空后即可释放
+            const bool isRetired = thread->isRetired.load(std::memory_order_acquire);
+            size_t count;
+            while ((count = thread->queue.TryPop(std::span(events))) != 0)
+                profileEvents.insert(profileEvents.end(), events, events + count);
+
+            if (isRetired)
+            {
+                if (const char* name = thread->name.load(std::memory_order_relaxed); name != nullptr)
+                    retiredProfileThreads.push_back({thread->index, name});
+                retiredDroppedCount += thread->droppedCount.load(std::memory_order_relaxed);
+            }
+            return isRetired;
+        });
+    }
+    static void WriteJsonString(std::ostream& stream, const char* text)
+    {
+        stream << '"';
+        for (; *text != '\0'; text++)
+        {
+            const char c = *text;
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+            else
+                stream << c;
+        }
+        stream << '"';
+    }
+
+    uint64_t Profiler::GetTimestamp()
+    {
+        const auto duration = std::chrono::steady_clock::now() - profileStartTime;
+        //加一以保证结果非零，零被ProfileZone用于表示未在采集
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) + 1;
+    }
+
+    void Profiler::BeginCapture()
+    {
+        std::lock_guard lock(profilerMutex);
+        CollectProfileEvents();
+        profileEvents.clear();
+        retiredProfileThreads.clear();
+        retiredDroppedCount = 0;
+        for (auto& thread : profileThreads)
+            thread->droppedCount = 0;
+        isCapturing = true;
+    }
+    void Profiler::EndCapture()
+    {
+        isCapturing = false;
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        GetProfileThread().name = name;
+    }
+    void Profiler::RecordZone(const char* name, const uint64_t beginTime, const uint64_t endTime)
+    {
+        ProfileEvent event;
+        event.name = name;
+        event.time = beginTime;
+        event.endTime = endTime;
+        event.type = ProfileEventType::Zone;
+        PushProfileEvent(event);
+    }
+    void Profiler::RecordCounter(const char* name, const double value)
+    {
+        if (!IsCapturing())
+            return;
+
+        ProfileEvent event;
+        event.name = name;
+        event.time = GetTimestamp();
+        event.value = value;
+        event.type = ProfileEventType::Counter;
+        PushProfileEvent(event);
+    }
+    void Profiler::MarkFrame()
+    {
+        if (!IsCapturing())
+            return;
+
+        ProfileEvent event;
+        event.name = "Frame";
+        event.time = GetTimestamp();
+        event.endTime = 0;
+        event.type = ProfileEventType::Frame;
+        PushProfileEvent(event);
+
+        std::lock_guard lock(profilerMutex);
+        CollectProfileEvents();
+    }
+
+    size_t Profiler::GetEventCount()
+    {
+        std::lock_guard lock(profilerMutex);
+        CollectProfileEvents();
+        return profileEvents.size();
+    }
+    size_t Profiler::GetDroppedEventCount()
+    {
+        std::lock_guard lock(profilerMutex);
+        size_t count = retiredDroppedCount;
+        for (auto& thread : profileThreads)
+            count += thread->droppedCount.load(std::memory_order_relaxed);
+        return count;
+    }
+    void Profiler::ExportChromeTrace(std::ostream& stream)
+    {
+        std::lock_guard lock(profilerMutex);
+        CollectProfileEvents();
+
+        //时间单位为微秒，保留到纳秒。导出后恢复调用者的流格式
+        const std::ios::fmtflags flags = stream.flags();
+        const std::streamsize precision = stream.precision();
+        const char fill = stream.fill();
+        stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        stream << std::fixed << std::setprecision(3);
+        bool isFirst = true;
+        auto beginEvent = [&stream,&isFirst]()-> std::ostream& {
+            stream << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+            return stream;
+        };
+
+        auto writeThreadName = [&stream,&beginEvent](const int index, const char* name)
+        {
+            if (name == nullptr)
+                return;
+            beginEvent() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << index << ",\"args\":{\"name\":";
+            WriteJsonString(stream, name);
+            stream << "}}";
+        };
+        for (auto& thread : profileThreads)
+            writeThreadName(thread->index, thread->name.load(std::memory_order_relaxed));
+        for (const RetiredProfileThread& thread : retiredProfileThreads)
+            writeThreadName(thread.index, thread.name);
+
+        for (const ProfileEvent& event : profileEvents)
+        {
+            beginEvent() << "{\"name\":";
+            WriteJsonString(stream, event.name);
+            stream << ",\"pid\":0,\"tid\":" << event.threadIndex << ",\"ts\":" << static_cast<double>(event.time) / 1000.0;
+            switch (event.type)
+            {
+            case ProfileEventType::Zone:
+                stream << ",\"ph\":\"X\",\"dur\":" << static_cast<double>(event.endTime - event.time) / 1000.0 << "}";
+                break;
+            case ProfileEventType::Counter:
+                stream << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+                break;
+            case ProfileEventType::Frame:
+                stream << ",\"ph\":\"i\",\"s\":\"g\"}";
+                break;
+            }
+        }
+        stream << "\n]}\n";
+        stream.flags(flags);
+        stream.precision(precision);
+        stream.fill(fill);
+    }
+}
@@ -0,0 +1,102 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * 定义Light_Profiler_Disable后，所有性能分析宏均展开为空，不产生任何开销
+ */
+#ifndef Light_Profiler_Disable
+#define Light_Profiler_Concat2(a, b) a##b
+#define Light_Profiler_Concat(a, b) Light_Profiler_Concat2(a, b)
+/**
+ * 记录从此处到所在作用域结束的耗时
+ * @param name 需为字符串字面量，导出前不会被复制
+ */
+#define LIGHT_PROFILE_ZONE(name) const ::Light::ProfileZone Light_Profiler_Concat(lightProfileZone, __LINE__)(name)
+/**
+ * 记录计数器的当前值
+ */
+#define LIGHT_PROFILE_COUNTER(name, value) ::Light::Profiler::RecordCounter(name, static_cast<double>(value))
+/**
+ * 标记一帧的结束
+ */
+#define LIGHT_PROFILE_FRAME() ::Light::Profiler::MarkFrame()
+#else
+#define LIGHT_PROFILE_ZONE(name) static_cast<void>(0)
+#define LIGHT_PROFILE_COUNTER(name, value) static_cast<void>(0)
+#define LIGHT_PROFILE_FRAME() static_cast<void>(0)
+#endif
+
+namespace Light
+{
+    /**
+     * 轻量的性能分析工具，结果可导出为Chrome Trace格式，用Perfetto（ui.perfetto.dev）或chrome://tracing查看
+     *
+     * 各线程将事件写入自己的无锁环形队列，仅在采集期间记录。标记帧或导出时由调用线程统一收集，
+     * 队列在两次收集间写满时会丢弃新事件，可通过GetDroppedEventCount查看。
+     */
+    class Profiler
+    {
+    public:
+        /**
+         * 获取自程序启动以来的纳秒数
+         * @return
+         */
+        static uint64_t GetTimestamp();
+
+        static bool IsCapturing() { return isCapturing.load(std::memory_order_relaxed); }
+        /**
+         * 开始采集，丢弃之前采集的所有事件
+         */
+        static void BeginCapture();
+        static void EndCapture();
+
+        /**
+         * 设置当前线程在导出结果中显示的名称
+         * @param name 需为字符串字面量
+         */
+        static void SetThreadName(const char* name);
+        static void RecordZone(const char* name, uint64_t beginTime, uint64_t endTime);
+        static void RecordCounter(const char* name, double value);
+        /**
+         * 标记一帧的结束，并收集各线程的事件以免队列写满
+         */
+        static void MarkFrame();
+
+        static size_t GetEventCount();
+        static size_t GetDroppedEventCount();
+        /**
+         * 收集各线程的事件，以Chrome Trace的JSON格式输出
+         * @param stream
+         */
+        static void ExportChromeTrace(std::ostream& stream);
+
+    private:
+        inline static std::atomic<bool> isCapturing = false;
+    };
+
+    /**
+     * 在析构时记录从构造开始的耗时，通常通过LIGHT_PROFILE_ZONE使用
+     */
+    class ProfileZone
+    {
+    public:
+        ProfileZone(const char* name)
+            : name(name), beginTime(Profiler::IsCapturing() ? Profiler::GetTimestamp() : 0)
+        {
+        }
+        ProfileZone(const ProfileZone&) = delete;
+        ~ProfileZone()
+        {
+            if (beginTime != 0)
+                Profiler::RecordZone(name, beginTime, Profiler::GetTimestamp());
+        }
+
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* name;
+        uint64_t beginTime;
+    };
+}
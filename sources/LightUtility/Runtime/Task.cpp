@@ -0,0 +1,53 @@
+﻿#include "Task.h"
+
+namespace Light
+{
+    void Coroutine::FileReadAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        FileIO::GetDefault().ReadAsync(path, [this,handle](std::vector<std::byte>& result, const std::exception_ptr& resultError)
+        {
+            data = std::move(result);
+            error = resultError;
+            //不在I/O线程上继续执行，以免阻塞其他读取
+            JobSystem::GetDefault().Schedule([handle] { handle.resume(); });
+        }, std::move(data));
+    }
+    std::vector<std::byte> Coroutine::FileReadAwaiter::await_resume()
+    {
+        if (error != nullptr)
+            std::rethrow_exception(error);
+        return std::move(data);
+    }
+
+    void Coroutine::MainThreadAwaiter::await_suspend(const std::coroutine_handle<> handle)
+    {
+        std::lock_guard lock(mainThreadMutex);
+        mainThreadWaiters.push_back({handle, std::move(predicate)});
+    }
+
+    void Coroutine::RunMainThread()
+    {
+        std::vector<MainThreadWaiter> waiters;
+        {
+            std::lock_guard lock(mainThreadMutex);
+            waiters.swap(mainThreadWaiters);
+        }
+
+        //恢复期间新加入的协程留到下次执行，条件未满足的协程重新放回
+        std::vector<MainThreadWaiter> pendingWaiters;
+        for (MainThreadWaiter& waiter : waiters)
+        {
+            if (waiter.predicate == nullptr || waiter.predicate())
+                waiter.handle.resume();
+            else
+                pendingWaiters.push_back(std::move(waiter));
+        }
+
+        if (!pendingWaiters.empty())
+        {
+            std::lock_guard lock(mainThreadMutex);
+            mainThreadWaiters.insert(mainThreadWaiters.begin(),
+                                     std::make_move_iterator(pendingWaiters.begin()), std::make_move_iterator(pendingWaiters.end()));
+        }
+    }
+}
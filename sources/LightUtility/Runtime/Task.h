@@ -0,0 +1,352 @@
+﻿#pragma once
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "FileIO.h"
+#include "JobSystem.h"
+
+namespace Light
+{
+    template <class TResult>
+    class Task;
+
+    /**
+     * Task协程的公共状态。协程在完成时若已有等待者则直接切换到等待者，否则唤醒通过Get阻塞等待的线程。
+     * 若Task在协程执行期间被销毁，协程会转为分离状态，完成时自行销毁协程帧
+     */
+    class TaskPromiseBase
+    {
+    public:
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+            template <class TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+            {
+                TaskPromiseBase& promise = handle.promise();
+                std::coroutine_handle<> continuation;
+                bool isDetached;
+                {
+                    std::lock_guard lock(promise.mutex);
+                    promise.isCompleted = true;
+                    continuation = promise.continuation;
+                    isDetached = promise.isDetached;
+                    promise.condition.notify_all();
+                }
+                //解锁后不能再访问协程帧，因为等待的线程可能已将其销毁；已分离时则没有其他所有者，由此处销毁
+                if (isDetached)
+                    handle.destroy();
+                return continuation ? continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept
+            {
+            }
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    protected:
+        template <class TResult>
+        friend class Task;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isStarted = false;
+        bool isCompleted = false;
+        bool isDetached = false;
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+    };
+    template <class TResult>
+    class TaskPromise : public TaskPromiseBase
+    {
+    public:
+        Task<TResult> get_return_object() noexcept;
+        void return_value(TResult value) { result.emplace(std::move(value)); }
+
+        TResult TakeResult()
+        {
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
+            return std::move(*result);
+        }
+
+    private:
+        std::optional<TResult> result;
+    };
+    template <>
+    class TaskPromise<void> : public TaskPromiseBase
+    {
+    public:
+        Task<void> get_return_object() noexcept;
+        void return_void() noexcept
+        {
+        }
+
+        void TakeResult()
+        {
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
+        }
+    };
+
+    /**
+     * 惰性启动的协程任务
+     *
+     * 被co_await时在等待者的线程上开始执行，完成时直接在完成的线程上恢复等待者，因此多阶段流程中不会有线程被阻塞。
+     * 协程可通过co_await Coroutine中的等待体切换到工作线程或主线程，或等待任务、文件读取和任意条件完成。
+     * @tparam TResult
+     */
+    template <class TResult = void>
+    class Task
+    {
+    public:
+        using promise_type = TaskPromise<TResult>;
+
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+            {
+                promise_type& promise = handle.promise();
+                std::lock_guard lock(promise.mutex);
+                if (!promise.isStarted)
+                {
+                    //尚未开始时直接切换到该任务执行
+                    promise.isStarted = true;
+                    promise.continuation = awaiting;
+                    return handle;
+                }
+                if (promise.isCompleted)
+                    return awaiting;
+                promise.continuation = awaiting;
+                return std::noop_coroutine();
+            }
+            TResult await_resume()
+            {
+                return handle.promise().TakeResult();
+            }
+        };
+
+        Task() = default;
+        Task(Task&& other) noexcept: handle(std::exchange(other.handle, nullptr))
+        {
+        }
+        Task(const Task&) = delete;
+        ~Task()
+        {
+            Release();
+        }
+
+        bool IsCompleted() const
+        {
+            std::lock_guard lock(handle.promise().mutex);
+            return handle.promise().isCompleted;
+        }
+
+        /**
+         * 在当前线程上开始执行，直到协程首次挂起
+         */
+        void Start()
+        {
+            {
+                std::lock_guard lock(handle.promise().mutex);
+                if (handle.promise().isStarted)
+                    return;
+                handle.promise().isStarted = true;
+            }
+            handle.resume();
+        }
+        /**
+         * 阻塞等待任务完成并获取结果，尚未开始时会先开始执行
+         *
+         * 不能在工作线程上等待需要该工作线程才能完成的任务，协程中应使用co_await。
+         * @return
+         */
+        TResult Get()
+        {
+            Start();
+            {
+                std::unique_lock lock(handle.promise().mutex);
+                handle.promise().condition.wait(lock, [this] { return handle.promise().isCompleted; });
+            }
+            return handle.promise().TakeResult();
+        }
+
+        Awaiter operator co_await() const noexcept
+        {
+            return Awaiter{handle};
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+        Task& operator=(const Task&) = delete;
+
+    private:
+        friend TaskPromise<TResult>;
+
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Task(const std::coroutine_handle<promise_type> handle): handle(handle)
+        {
+        }
+
+        /**
+         * 销毁协程帧。未开始或已完成的协程帧可以安全销毁，
+         * 但已开始尚未完成的协程之后仍会被恢复，此时将其分离，由协程完成时自行销毁，其结果和异常会被丢弃
+         */
+        void Release()
+        {
+            if (!handle)
+                return;
+
+            bool isRunning;
+            {
+                std::lock_guard lock(handle.promise().mutex);
+                isRunning = handle.promise().isStarted && !handle.promise().isCompleted;
+                if (isRunning)
+                    handle.promise().isDetached = true;
+            }
+            if (!isRunning)
+                handle.destroy();
+            handle = nullptr;
+        }
+    };
+
+    template <class TResult>
+    Task<TResult> TaskPromise<TResult>::get_return_object() noexcept
+    {
+        return Task<TResult>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+    }
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept
+    {
+        return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+    }
+
+    /**
+     * 供协程co_await的等待体
+     */
+    class Coroutine
+    {
+    public:
+        struct JobSystemAwaiter
+        {
+            JobSystem& jobSystem;
+            JobHandle job;
+
+            bool await_ready() const { return job.IsValid() && job.IsCompleted(); }
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                if (job.IsValid())
+                    jobSystem.ContinueWith(job, [handle] { handle.resume(); });
+                else
+                    jobSystem.Schedule([handle] { handle.resume(); });
+            }
+            void await_resume() const
+            {
+            }
+        };
+        struct FileReadAwaiter
+        {
+            std::filesystem::path path;
+            std::vector<std::byte> data; //读取前为目标缓冲区，读取后为结果
+            std::exception_ptr error;
+
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> handle);
+            std::vector<std::byte> await_resume();
+        };
+        struct MainThreadAwaiter
+        {
+            std::function<bool()> predicate;
+
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> handle);
+            void await_resume() const
+            {
+            }
+        };
+
+        /**
+         * 切换到工作线程继续执行
+         * @param jobSystem
+         * @return
+         */
+        static JobSystemAwaiter SwitchToJobSystem(JobSystem& jobSystem = JobSystem::GetDefault())
+        {
+            return {jobSystem, {}};
+        }
+        /**
+         * 等待任务完成后在工作线程上继续执行
+         * @param job 需由jobSystem提交
+         * @param jobSystem
+         * @return
+         */
+        static JobSystemAwaiter WaitJob(const JobHandle& job, JobSystem& jobSystem = JobSystem::GetDefault())
+        {
+            return {jobSystem, job};
+        }
+        /**
+         * 通过FileIO异步读取整个文件，完成后在工作线程上继续执行，失败时在co_await处抛出异常
+         * @param path
+         * @param buffer 读取的目标缓冲区，可由FileIO::AcquireBuffer获取以复用内存
+         * @return
+         */
+        static FileReadAwaiter ReadFile(std::filesystem::path path, std::vector<std::byte> buffer = {})
+        {
+            return {std::move(path), std::move(buffer), {}};
+        }
+        /**
+         * 切换到主线程继续执行，即下次调用RunMainThread时
+         * @return
+         */
+        static MainThreadAwaiter SwitchToMainThread()
+        {
+            return {nullptr};
+        }
+        /**
+         * 由主线程每次调用RunMainThread时检查条件，条件满足后在主线程上继续执行，
+         * 适合等待无法主动通知的事件，如GPU栅栏
+         * @param predicate 在主线程上调用
+         * @return
+         */
+        static MainThreadAwaiter WaitUntil(std::function<bool()> predicate)
+        {
+            return {std::move(predicate)};
+        }
+
+        /**
+         * 恢复所有切换到主线程的协程，以及条件已满足的协程，应在主线程上每帧调用
+         */
+        static void RunMainThread();
+
+    private:
+        struct MainThreadWaiter
+        {
+            std::coroutine_handle<> handle;
+            std::function<bool()> predicate;
+        };
+
+        inline static std::mutex mainThreadMutex;
+        inline static std::vector<MainThreadWaiter> mainThreadWaiters;
+    };
+}
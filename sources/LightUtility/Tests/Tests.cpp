@@ -2,11 +2,26 @@
 #include <gtest/gtest.h>
 #include <benchmark/benchmark.h>
 #include <condition_variable>
+#include <fstream>
+#include <iomanip>
 #include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <sstream>
 
 #include "LightUtility/Runtime/Chronograph.hpp"
 #include "LightUtility/Runtime/ObjectPool.hpp"
-#include "LightUtility/Runtime/ThreadPool.h"
+#include "LightUtility/Runtime/FileIO.h"
+#include "LightUtility/Runtime/FrameArena.h"
+#include "LightUtility/Runtime/InplaceFunction.hpp"
+#include "LightUtility/Runtime/JobSystem.h"
+#include "LightUtility/Runtime/LockFreeQueue.hpp"
+#include "LightUtility/Runtime/Logger.h"
+#include "LightUtility/Runtime/MemoryTracker.h"
+#include "LightUtility/Runtime/Profiler.h"
+#include "LightUtility/Runtime/Parallel.hpp"
+#include "LightUtility/Runtime/Task.h"
 
 using namespace Light;
 
@@ -51,57 +66,725 @@ TEST(Utility, ObjectPool)
     ASSERT_EQ(recycleCount, 2);
 }
 
-TEST(Utility, Worker)
+TEST(Utility, ObjectPoolThreadCache)
 {
-    Worker worker = Worker();
-    worker.Execute(
-        [] { std::cout << "执行1\n"; },
-        [] { std::cout << "完成1\n"; }
-    );
-    worker.Execute(
-        []
+    struct Object
+    {
+        std::atomic<bool> isUsing = false;
+        int value = 0;
+    };
+
+    constexpr int threadCount = 4;
+    ObjectPool<Object> objPool = {ObjectPoolThreading::ThreadCache};
+    {
+        std::vector<std::jthread> threads;
+        for (int thread = 0; thread < threadCount; thread++)
         {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            std::cout << "执行2\n";
-        },
-        [] { std::cout << "完成3\n"; }
-    );
-    worker.Execute(
-        [] { std::cout << "执行3\n"; },
-        [] { std::cout << "完成3\n"; }
-    );
+            threads.emplace_back([&objPool,thread]
+            {
+                std::vector<Object*> objects;
+                for (int round = 0; round < 1000; round++)
+                {
+                    //每轮获取数量不同，以覆盖缓存的补充和归还
+                    for (int i = 0; i < (round + thread) % 80; i++)
+                    {
+                        Object& object = objPool.Get();
+                        ASSERT_FALSE(object.isUsing.exchange(true));
+                        object.value = thread;
+                        objects.push_back(&object);
+                    }
+                    for (Object* object : objects)
+                    {
+                        ASSERT_EQ(object->value, thread);
+                        object->isUsing = false;
+                        objPool.Release(*object);
+                    }
+                    objects.clear();
+                }
+            });
+        }
+    }
+    ASSERT_EQ(objPool.GetUsableObjectsCount(), objPool.GetAllObjectsCount());
+    ASSERT_LE(objPool.GetAllObjectsCount(), threadCount * (80 + 32));
 
-    std::cout << "布置完成\n" << std::flush;
+    //大量短暂线程依次使用时，退出的线程归还缓存和索引，后续线程可以复用
+    ObjectPool<Object> shortLivedPool = {ObjectPoolThreading::ThreadCache};
+    for (int thread = 0; thread < 100; thread++)
+    {
+        std::jthread([&shortLivedPool]
+        {
+            std::vector<Object*> objects;
+            for (int i = 0; i < 10; i++)
+                objects.push_back(&shortLivedPool.Get());
+            for (Object* object : objects)
+                shortLivedPool.Release(*object);
+        }).join();
+    }
+    ASSERT_EQ(shortLivedPool.GetAllObjectsCount(), 10);
+    ASSERT_EQ(shortLivedPool.GetUsableObjectsCount(), 10);
+    int threadIndex = -1;
+    std::jthread([&threadIndex] { threadIndex = ObjectPoolThreadIndex::Get(); }).join();
+    ASSERT_LT(threadIndex, threadCount + 1);
 }
 
-TEST(Utility, ThreadPool)
+TEST(Utility, LinearArena)
 {
-    ThreadPool pool;
+    LinearArena arena = {1024};
+    std::span<int> values = arena.Allocate<int>(100);
+    ASSERT_TRUE(std::ranges::all_of(values, [](const int value) { return value == 0; }));
+    void* aligned = arena.Allocate(1, 256);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 256, 0);
+    ASSERT_EQ(arena.GetBlockCount(), 1);
 
-    pool.Schedule([]
+    //超出容量时追加新块，重置后合并为一个块，相同用量不再追加
+    for (int i = 0; i < 2; i++)
     {
-        std::this_thread::sleep_for(std::chrono::seconds(3));
-    }, [] { std::cout << "Finish Task 1\n" << std::flush; });
-    pool.Schedule([]
+        std::pmr::vector<int> vector(&arena);
+        for (int j = 0; j < 1000; j++)
+            vector.push_back(j);
+        ASSERT_EQ(vector[999], 999);
+        ASSERT_GE(arena.GetUsedSize(), 4000);
+        arena.Reset();
+        ASSERT_EQ(arena.GetBlockCount(), 1);
+        ASSERT_EQ(arena.GetUsedSize(), 0);
+    }
+    const size_t capacity = arena.GetCapacity();
+    {
+        std::pmr::vector<int> vector(&arena);
+        for (int j = 0; j < 1000; j++)
+            vector.push_back(j);
+    }
+    ASSERT_EQ(arena.GetBlockCount(), 1);
+    ASSERT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(Utility, FrameArena)
+{
+    //分配的内存保留到下一帧结束
+    std::span<int> frame0 = FrameArena::Allocate<int>(4);
+    std::ranges::fill(frame0, 1);
+    FrameArena::EndFrame();
+    std::span<int> frame1 = FrameArena::Allocate<int>(4);
+    std::ranges::fill(frame1, 2);
+    ASSERT_TRUE(std::ranges::all_of(frame0, [](const int value) { return value == 1; }));
+    FrameArena::EndFrame();
+    ASSERT_EQ(FrameArena::GetResource().GetUsedSize(), 0);
+    ASSERT_TRUE(std::ranges::all_of(frame1, [](const int value) { return value == 2; }));
+
+    //各线程使用各自的分配器
+    LinearArena* mainArena = &FrameArena::GetResource();
+    LinearArena* otherArena = nullptr;
+    std::jthread([&otherArena] { otherArena = &FrameArena::GetResource(); }).join();
+    ASSERT_NE(mainArena, otherArena);
+}
+
+TEST(Utility, JobSystem)
+{
+    JobSystem jobSystem = {4};
+    ASSERT_EQ(jobSystem.GetThreadCount(), 4);
+
+    //大量独立任务
+    std::atomic<int> counter = 0;
+    for (int i = 0; i < 10000; i++)
+        jobSystem.Schedule([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+    jobSystem.WaitAll();
+    ASSERT_EQ(counter, 10000);
+
+    //任务中继续提交任务，覆盖工作线程自身队列和窃取的情况
+    counter = 0;
+    jobSystem.Schedule([&jobSystem,&counter]
+    {
+        for (int i = 0; i < 100; i++)
+            jobSystem.Schedule([&jobSystem,&counter]
+            {
+                for (int j = 0; j < 100; j++)
+                    jobSystem.Schedule([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            });
+    });
+    jobSystem.WaitAll();
+    ASSERT_EQ(counter, 10000);
+
+    //依赖和后续任务按顺序执行
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&order,&orderMutex](int value)
+    {
+        return [&order,&orderMutex,value]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(value % 2 == 0 ? 20 : 0));
+            std::lock_guard lock(orderMutex);
+            order.push_back(value);
+        };
+    };
+    JobHandle first = jobSystem.Schedule(record(0));
+    JobHandle second = jobSystem.Schedule(record(1));
+    JobHandle third = jobSystem.Schedule(record(2), {first, second});
+    JobHandle fourth = jobSystem.ContinueWith(third, record(3));
+    jobSystem.Wait(fourth);
+    ASSERT_TRUE(first.IsCompleted() && second.IsCompleted() && third.IsCompleted() && fourth.IsCompleted());
+    ASSERT_EQ(order.size(), 4);
+    ASSERT_EQ(order[2], 2);
+    ASSERT_EQ(order[3], 3);
+
+    //依赖已完成的任务时立即可执行
+    JobHandle fifth = jobSystem.ContinueWith(fourth, record(4));
+    jobSystem.Wait(fifth);
+    ASSERT_EQ(order.back(), 4);
+
+    //等待期间新提交的任务也由等待的线程协助执行：唯一的工作线程在任务中等待自己提交的任务，只能由外部等待线程窃取执行
+    JobSystem singleSystem = {1};
+    std::atomic<bool> isStarted = false;
+    JobHandle outer = singleSystem.Schedule([&singleSystem,&isStarted]
     {
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-    }, [] { std::cout << "Finish Task 2\n" << std::flush; });
-    pool.Schedule([]
+        isStarted = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        JobHandle inner = singleSystem.Schedule([] {});
+        while (!inner.IsCompleted())
+            std::this_thread::yield();
+    });
+    while (!isStarted)
+        std::this_thread::yield();
+    singleSystem.Wait(outer);
+    ASSERT_TRUE(outer.IsCompleted());
+}
+
+TEST(Utility, JobSystemWithoutThreads)
+{
+    //没有工作线程时，所有任务由等待的线程执行
+    JobSystem jobSystem = {0};
+    std::vector<int> order;
+    JobHandle first = jobSystem.Schedule([&order] { order.push_back(0); });
+    JobHandle second = jobSystem.ContinueWith(first, [&order] { order.push_back(1); });
+    jobSystem.Schedule([&order] { order.push_back(2); }, {second});
+    ASSERT_TRUE(order.empty());
+    jobSystem.Wait(second);
+    ASSERT_EQ(order, (std::vector{0, 1}));
+    jobSystem.WaitAll();
+    ASSERT_EQ(order, (std::vector{0, 1, 2}));
+}
+
+TEST(Utility, Parallel)
+{
+    constexpr int count = 100000;
+
+    std::vector<int> visits(count);
+    Parallel::For(0, count, [&visits](const int i) { visits[i]++; });
+    ASSERT_TRUE(std::ranges::all_of(visits, [](const int value) { return value == 1; }));
+    Parallel::For(0, count, [&visits](const int begin, const int end)
     {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-    }, [] { std::cout << "Finish Task 3\n" << std::flush; });
+        for (int i = begin; i < end; i++)
+            visits[i]++;
+    }, 1000);
+    ASSERT_TRUE(std::ranges::all_of(visits, [](const int value) { return value == 2; }));
 
-    std::cout << "Submit Finished\n" << std::flush;
+    const int64_t sum = Parallel::Reduce(0, count, int64_t{0},
+                                         [](const int i) { return static_cast<int64_t>(i) * i; },
+                                         std::plus<>());
+    ASSERT_EQ(sum, static_cast<int64_t>(count - 1) * count * (2 * count - 1) / 6);
+    //只满足结合律的操作也要保持顺序
+    const std::string text = Parallel::Reduce(0, 26, std::string(),
+                                              [](const int i) { return std::string(1, static_cast<char>('a' + i)); },
+                                              std::plus<>(), 3);
+    ASSERT_EQ(text, "abcdefghijklmnopqrstuvwxyz");
 
-    ASSERT_EQ(pool.GetThreadCount(), 3);
+    //排序需保持稳定，相同键按原顺序排列
+    std::mt19937 random(1);
+    std::vector<std::pair<int, int>> pairs(count);
+    for (int i = 0; i < count; i++)
+        pairs[i] = {static_cast<int>(random() % 1000), i};
+    std::vector<std::pair<int, int>> expected = pairs;
+    auto compareKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    std::ranges::stable_sort(expected, compareKey);
+    Parallel::Sort(std::span(pairs), compareKey);
+    ASSERT_EQ(pairs, expected);
 
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    std::vector<int> values(count);
+    for (int& value : values)
+        value = static_cast<int>(random() % 100);
+    std::vector<int> exclusive(count);
+    std::exclusive_scan(values.begin(), values.end(), exclusive.begin(), 0);
+    std::vector<int> inclusive(count);
+    std::inclusive_scan(values.begin(), values.end(), inclusive.begin());
+    std::vector<int> output(count);
+    ASSERT_EQ(Parallel::ExclusiveScan(std::span(values), std::span(output)), inclusive.back());
+    ASSERT_EQ(output, exclusive);
+    //原地计算
+    Parallel::InclusiveScan(std::span(values), std::span(values));
+    ASSERT_EQ(values, inclusive);
+}
 
-    pool.Schedule([]
+TEST(Utility, SPSCQueue)
+{
+    SPSCQueue<int> queue = {5};
+    ASSERT_EQ(queue.GetCapacity(), 8);
+    for (int i = 0; i < 8; i++)
+        ASSERT_TRUE(queue.TryPush(i));
+    ASSERT_FALSE(queue.TryPush(8));
+    int values[5];
+    ASSERT_EQ(queue.TryPop(std::span(values)), 5);
+    ASSERT_EQ(values[4], 4);
+    //跨越缓冲区末尾的批量操作
+    int moreValues[] = {8, 9, 10, 11, 12, 13};
+    ASSERT_EQ(queue.TryPush(std::span(moreValues)), 5);
+    ASSERT_EQ(queue.GetCount(), 8);
+    for (int i = 5; i < 13; i++)
     {
-    }, [] { std::cout << "Finish Task 4\n" << std::flush; });
+        int value;
+        ASSERT_TRUE(queue.TryPop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_EQ(queue.TryPop(std::span(values)), 0);
 
-    ASSERT_EQ(pool.GetThreadCount(), 3);
+    //跨线程传递时保持顺序
+    constexpr int count = 1000000;
+    std::jthread producer([&queue]
+    {
+        for (int i = 0; i < count; i++)
+            while (!queue.TryPush(i))
+                std::this_thread::yield();
+    });
+    for (int i = 0; i < count;)
+    {
+        const size_t popCount = queue.TryPop(std::span(values));
+        for (size_t j = 0; j < popCount; j++, i++)
+            ASSERT_EQ(values[j], i);
+        if (popCount == 0)
+            std::this_thread::yield();
+    }
+}
+
+TEST(Utility, MPMCQueue)
+{
+    constexpr int threadCount = 4;
+    constexpr int countPerThread = 100000;
+    MPMCQueue<int> queue = {1024};
+    std::vector<std::atomic<int>> visits(threadCount * countPerThread);
+    {
+        std::vector<std::jthread> threads;
+        for (int thread = 0; thread < threadCount; thread++)
+        {
+            threads.emplace_back([&queue,thread]
+            {
+                //交替使用单个和批量压入
+                for (int i = 0; i < countPerThread; i += 4)
+                {
+                    int values[4];
+                    for (int j = 0; j < 4; j++)
+                        values[j] = thread * countPerThread + i + j;
+                    std::span<int> remaining = values;
+                    if (i % 8 == 0)
+                    {
+                        while (!remaining.empty())
+                            remaining = remaining.subspan(queue.TryPush(remaining));
+                    }
+                    else
+                    {
+                        for (const int value : remaining)
+                            while (!queue.TryPush(value))
+                                std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&queue,&visits]
+            {
+                int values[3];
+                for (int popCount = 0; popCount < countPerThread;)
+                {
+                    const size_t count = queue.TryPop(std::span(values, std::min(3, countPerThread - popCount)));
+                    for (size_t i = 0; i < count; i++)
+                        visits[values[i]]++;
+                    popCount += static_cast<int>(count);
+                    if (count == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+    }
+    ASSERT_TRUE(std::ranges::all_of(visits, [](const std::atomic<int>& value) { return value == 1; }));
+}
+
+TEST(Utility, Profiler)
+{
+    //未采集时不记录
+    {
+        LIGHT_PROFILE_ZONE("Ignored");
+    }
+    Profiler::BeginCapture();
+    ASSERT_EQ(Profiler::GetEventCount(), 0);
+
+    Profiler::SetThreadName("Main");
+    {
+        LIGHT_PROFILE_ZONE("Outer");
+        std::jthread([]
+        {
+            Profiler::SetThreadName("Worker \"1\"");
+            LIGHT_PROFILE_ZONE("Inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }).join();
+        LIGHT_PROFILE_COUNTER("Entities", 42);
+    }
+    LIGHT_PROFILE_FRAME();
+    Profiler::EndCapture();
+    {
+        LIGHT_PROFILE_ZONE("Ignored");
+    }
+    ASSERT_EQ(Profiler::GetEventCount(), 4);
+    ASSERT_EQ(Profiler::GetDroppedEventCount(), 0);
+
+    std::stringstream stream;
+    stream << std::setprecision(4);
+    Profiler::ExportChromeTrace(stream);
+    const std::string trace = stream.str();
+    ASSERT_TRUE(trace.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    ASSERT_TRUE(trace.ends_with("\n]}\n"));
+    //两个线程名称及四个事件各占一行，结尾的括号单独一行
+    ASSERT_EQ(std::ranges::count(trace, '\n'), 2 + 4 + 2);
+    ASSERT_NE(trace.find(R"({"name":"Outer","pid":0,"tid":)"), std::string::npos);
+    ASSERT_NE(trace.find(R"("name":"Inner")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("args":{"name":"Worker \"1\""})"), std::string::npos);
+    ASSERT_NE(trace.find(R"("ph":"C","args":{"value":42.000})"), std::string::npos);
+    ASSERT_NE(trace.find(R"("ph":"i","s":"g")"), std::string::npos);
+    ASSERT_EQ(trace.find("Ignored"), std::string::npos);
+    //恢复调用者的流格式
+    ASSERT_EQ(stream.precision(), 4);
+    ASSERT_FALSE(stream.flags() & std::ios::fixed);
+}
+
+TEST(Utility, FileIO)
+{
+    std::vector<std::byte> content(100000);
+    for (size_t i = 0; i < content.size(); i++)
+        content[i] = static_cast<std::byte>(i * 7);
+    std::ofstream("fileIO.bin", std::ios::binary).write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+
+    FileIO fileIO = {2};
+    //同时提交多个请求
+    std::vector<std::future<std::vector<std::byte>>> futures;
+    for (int i = 0; i < 8; i++)
+        futures.push_back(fileIO.ReadAsync("fileIO.bin"));
+    for (auto& future : futures)
+        ASSERT_EQ(future.get(), content);
+
+    //复用之前的缓冲区
+    std::vector<std::byte> buffer = FileIO::Read("fileIO.bin");
+    const std::byte* bufferData = buffer.data();
+    std::promise<const std::byte*> promise;
+    fileIO.ReadAsync("fileIO.bin", [&promise,&content](std::vector<std::byte>& data, const std::exception_ptr& error)
+    {
+        ASSERT_EQ(error, nullptr);
+        ASSERT_EQ(data, content);
+        promise.set_value(data.data());
+    }, std::move(buffer));
+    ASSERT_EQ(promise.get_future().get(), bufferData);
+
+    //池化的缓冲区归还后再次取出时保留容量
+    std::vector<std::byte> pooled = fileIO.ReadAsync("fileIO.bin", fileIO.AcquireBuffer()).get();
+    const std::byte* pooledData = pooled.data();
+    fileIO.RecycleBuffer(std::move(pooled));
+    std::vector<std::byte> reused = fileIO.AcquireBuffer();
+    ASSERT_TRUE(reused.empty());
+    ASSERT_EQ(reused.data(), pooledData);
+    ASSERT_EQ(fileIO.ReadAsync("fileIO.bin", std::move(reused)).get(), content);
+
+    //读取部分内容，超出末尾时只读取剩余部分
+    std::byte range[1000];
+    ASSERT_EQ(fileIO.ReadRangeAsync("fileIO.bin", 5000, range).get(), 1000);
+    ASSERT_TRUE(std::equal(std::begin(range), std::end(range), content.begin() + 5000));
+    ASSERT_EQ(fileIO.ReadRangeAsync("fileIO.bin", content.size() - 10, range).get(), 10);
+
+    ASSERT_THROW(fileIO.ReadAsync("missing.bin").get(), std::runtime_error);
+
+    std::shared_ptr<MappedFile> mappedFile = FileIO::Map("fileIO.bin");
+    ASSERT_TRUE(std::ranges::equal(mappedFile->GetData(), content));
+}
+
+LogModule TestLog = {"Test", LogLevel::Debug};
+struct LogPoint
+{
+    int x;
+    int y;
+};
+template <>
+struct std::formatter<LogPoint> : std::formatter<int>
+{
+    std::format_context::iterator format(const LogPoint& point, std::format_context& context) const
+    {
+        context.advance_to(std::formatter<int>::format(point.x, context));
+        *context.out()++ = ',';
+        return std::formatter<int>::format(point.y, context);
+    }
+};
+
+TEST(Utility, Logger)
+{
+    //先输出其他测试（如FileIO读取失败）留下的日志
+    Logger::Flush();
+    std::filesystem::remove("logger.log");
+    Logger::SetConsoleOutput(false);
+    Logger::SetFileOutput("logger.log");
+
+    LIGHT_LOG_DEBUG(TestLog, "Value:{} {:.2f} {:>5} {}", 42, 3.14159, "ab", true);
+    //浮点数按原类型的最短表示输出
+    LIGHT_LOG_DEBUG(TestLog, "Float:{} {} {}", 0.1f, 0.1, 0.1L);
+    //自定义类型在调用线程上按其格式说明格式化
+    LIGHT_LOG_DEBUG(TestLog, "Point:{:03} {}", LogPoint{1, 2}, 3);
+    //保存的参数不支持原格式说明时，保留格式字符串和参数值
+    LIGHT_LOG_DEBUG(TestLog, "Address:{:p} {}", "ab", 3);
+    LIGHT_LOG_TRACE(TestLog, "Hidden");
+    //未启用的级别不对参数求值
+    int evaluated = 0;
+    LIGHT_LOG_TRACE(TestLog, "{}", ++evaluated);
+    ASSERT_EQ(evaluated, 0);
+    //按模块过滤
+    ASSERT_TRUE(Logger::SetLevel("Test", LogLevel::Warning));
+    //析构的模块不再能被设置
+    {
+        LogModule scopedLog = {"Scoped"};
+        ASSERT_TRUE(Logger::SetLevel("Scoped", LogLevel::Warning));
+    }
+    ASSERT_FALSE(Logger::SetLevel("Scoped", LogLevel::Warning));
+    LIGHT_LOG_INFO(TestLog, "Filtered");
+    LIGHT_LOG_WARNING(TestLog, "Warning:{:#x}", 255u);
+    TestLog.SetLevel(LogLevel::Debug);
+
+    //多个线程同时记录
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([t]
+            {
+                for (int i = 0; i < 100; i++)
+                    LIGHT_LOG_INFO(TestLog, "Thread{}:{}", t, i);
+            });
+        }
+    }
+    //过长的文本被截断
+    LIGHT_LOG_INFO(TestLog, "Long:{}", std::string(200, 'x'));
+
+    Logger::Flush();
+    Logger::SetFileOutput({});
+    Logger::SetConsoleOutput(true);
+    ASSERT_EQ(Logger::GetDroppedRecordCount(), 0);
+
+    std::ifstream file("logger.log");
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(file, line))
+        lines.push_back(line);
+    ASSERT_EQ(lines.size(), 5 + 400 + 1);
+    ASSERT_NE(lines[0].find("[Debug][Test]"), std::string::npos);
+    ASSERT_TRUE(lines[0].ends_with("Value:42 3.14    ab true"));
+    ASSERT_TRUE(lines[1].ends_with("Float:0.1 0.1 0.1"));
+    ASSERT_TRUE(lines[2].ends_with("Point:001,002 3"));
+    ASSERT_TRUE(lines[3].ends_with("Address:{:p} {} [ab, 3]"));
+    ASSERT_NE(lines[4].find("Warning:0xff (" __FILE__), std::string::npos);
+    int nextIndices[4] = {};
+    for (int i = 5; i < 405; i++)
+    {
+        const size_t position = lines[i].find("Thread");
+        ASSERT_NE(position, std::string::npos);
+        const int thread = lines[i][position + 6] - '0';
+        //同一线程的日志保持顺序
+        ASSERT_TRUE(lines[i].ends_with(std::format(":{}", nextIndices[thread]++)));
+    }
+    ASSERT_TRUE(lines[405].ends_with("Long:" + std::string(LogRecord::TextCapacity, 'x')));
+}
+
+TEST(Utility, InplaceFunction)
+{
+    InplaceFunction<int(int)> function;
+    ASSERT_FALSE(function);
+    ASSERT_TRUE(function == nullptr);
+
+    int offset = 10;
+    function = [&offset](const int value) { return value + offset; };
+    ASSERT_EQ(function(5), 15);
+
+    //不可平凡复制的可调用对象在移动和析构时正确管理生命周期
+    std::shared_ptr<int> shared = std::make_shared<int>(3);
+    InplaceFunction<int(int), 48> owner = [shared](const int value) { return value * *shared; };
+    ASSERT_EQ(shared.use_count(), 2);
+    InplaceFunction<int(int), 48> moved = std::move(owner);
+    ASSERT_FALSE(owner);
+    ASSERT_EQ(shared.use_count(), 2);
+    ASSERT_EQ(moved(4), 12);
+    moved = nullptr;
+    ASSERT_EQ(shared.use_count(), 1);
+
+    //参数和返回值按引用传递
+    std::string text;
+    const InplaceFunction<std::string&(std::string&, std::string&&)> append = [](std::string& target, std::string&& value) -> std::string&
+    {
+        return target += value;
+    };
+    ASSERT_EQ(&append(text, "abc"), &text);
+    ASSERT_EQ(text, "abc");
+
+    //仅可移动的可调用对象也可存放
+    InplaceFunction<int()> unique = [pointer = std::make_unique<int>(7)] { return *pointer; };
+    std::vector<InplaceFunction<int()>> functions;
+    functions.push_back(std::move(unique));
+    functions.emplace_back([] { return 1; });
+    ASSERT_EQ(functions[0]() + functions[1](), 8);
+}
+
+TEST(Utility, MemoryTracker)
+{
+    MemoryTracker::EndFrame();
+    const MemoryStatistics before = MemoryTracker::GetStatistics(MemoryTag::General);
+
+    MemoryTracker::SetCallSiteCapture(true);
+    const std::source_location location = std::source_location::current();
+    {
+        const MemoryCallSiteScope scope(location);
+        TrackedVector<int, MemoryTag::General> vector;
+        vector.reserve(1000);
+        MemoryStatistics statistics = MemoryTracker::GetStatistics(MemoryTag::General);
+        ASSERT_EQ(statistics.currentBytes - before.currentBytes, sizeof(int) * 1000);
+        ASSERT_EQ(statistics.allocationCount - before.allocationCount, 1);
+
+        //嵌套时以最外层为准
+        const MemoryCallSiteScope innerScope;
+        vector.resize(5000);
+        statistics = MemoryTracker::GetStatistics(MemoryTag::General);
+        ASSERT_EQ(statistics.currentBytes - before.currentBytes, sizeof(int) * 5000);
+        ASSERT_EQ(statistics.peakBytes - before.currentBytes, sizeof(int) * 6000);
+    }
+    MemoryTracker::SetCallSiteCapture(false);
+
+    MemoryTracker::EndFrame();
+    const MemoryStatistics after = MemoryTracker::GetStatistics(MemoryTag::General);
+    ASSERT_EQ(after.currentBytes, before.currentBytes);
+    ASSERT_EQ(after.deallocationCount - before.deallocationCount, 2);
+    ASSERT_EQ(after.frameAllocationCount, 2);
+    ASSERT_EQ(after.frameAllocatedBytes, sizeof(int) * 6000);
+    ASSERT_EQ(MemoryTracker::GetHistory(MemoryTag::General).back(), static_cast<float>(after.currentBytes));
+
+    //分配归属到作用域的调用点
+    std::vector<MemoryCallSite> callSites = MemoryTracker::GetCallSites();
+    ASSERT_EQ(callSites.size(), 1);
+    ASSERT_EQ(callSites[0].file, location.file_name());
+    ASSERT_EQ(callSites[0].line, location.line());
+    ASSERT_EQ(callSites[0].allocationCount, 2);
+    ASSERT_EQ(callSites[0].allocatedBytes, sizeof(int) * 6000);
+
+    //对象池按块记录，并归属到调用Get的位置
+    const size_t poolBytes = MemoryTracker::GetStatistics(MemoryTag::ObjectPool).currentBytes;
+    MemoryTracker::SetCallSiteCapture(true);
+    {
+        ObjectPool<int> pool;
+        const uint32_t line = std::source_location::current().line() + 1;
+        pool.Release(pool.Get());
+        ASSERT_GT(MemoryTracker::GetStatistics(MemoryTag::ObjectPool).currentBytes, poolBytes);
+        //作用域外的分配记录为未标记
+        TrackedVector<int, MemoryTag::General> vector(10);
+        MemoryTracker::SetCallSiteCapture(false);
+
+        callSites = MemoryTracker::GetCallSites();
+        ASSERT_EQ(callSites.size(), 2);
+        const auto poolCallSite = std::ranges::find(callSites, MemoryTag::ObjectPool, &MemoryCallSite::tag);
+        ASSERT_EQ(poolCallSite->file, location.file_name());
+        ASSERT_EQ(poolCallSite->line, line);
+        const auto unmarkedCallSite = std::ranges::find(callSites, MemoryTag::General, &MemoryCallSite::tag);
+        ASSERT_TRUE(unmarkedCallSite->file.empty());
+        ASSERT_EQ(unmarkedCallSite->allocatedBytes, sizeof(int) * 10);
+    }
+    ASSERT_EQ(MemoryTracker::GetStatistics(MemoryTag::ObjectPool).currentBytes, poolBytes);
+}
+
+Task<int> SumFileAsync(const std::filesystem::path& path)
+{
+    std::vector<std::byte> data = co_await Coroutine::ReadFile(path);
+    int sum = 0;
+    for (const std::byte value : data)
+        sum += static_cast<int>(value);
+    co_return sum;
+}
+Task<int> LoadPipelineAsync(const std::thread::id mainThread, std::atomic<int>& counter, bool& isReady)
+{
+    //读取文件，完成后已在工作线程上
+    const int sum = co_await SumFileAsync("task.bin");
+    if (std::this_thread::get_id() == mainThread)
+        throw std::runtime_error("未切换到工作线程！");
+
+    //等待由其他代码提交的任务
+    JobHandle job = JobSystem::GetDefault().Schedule([&counter] { counter += 10; });
+    co_await Coroutine::WaitJob(job);
+    if (counter != 10)
+        throw std::runtime_error("任务未完成！");
+
+    //回到主线程并等待条件满足
+    co_await Coroutine::SwitchToMainThread();
+    if (std::this_thread::get_id() != mainThread)
+        throw std::runtime_error("未切换到主线程！");
+    co_await Coroutine::WaitUntil([&isReady] { return isReady; });
+
+    co_await Coroutine::SwitchToJobSystem();
+    co_return sum + counter;
+}
+Task<> ThrowAsync()
+{
+    co_await Coroutine::SwitchToJobSystem();
+    throw std::runtime_error("Task");
+}
+
+TEST(Utility, Task)
+{
+    std::vector<std::byte> content(1000);
+    for (size_t i = 0; i < content.size(); i++)
+        content[i] = static_cast<std::byte>(i % 3);
+    std::ofstream("task.bin", std::ios::binary).write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+
+    std::atomic counter = 0;
+    bool isReady = false;
+    Task<int> task = LoadPipelineAsync(std::this_thread::get_id(), counter, isReady);
+    task.Start();
+    //模拟主循环，若干帧后条件才满足
+    for (int frame = 0; !task.IsCompleted(); frame++)
+    {
+        isReady = frame >= 10;
+        Coroutine::RunMainThread();
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(task.Get(), 999 + 10);
+
+    //异常传递到等待者
+    ASSERT_THROW(ThrowAsync().Get(), std::runtime_error);
+    ASSERT_THROW(SumFileAsync("missing.bin").Get(), std::runtime_error);
+
+    //大量任务同时在工作线程上运行
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 1000; i++)
+    {
+        tasks.push_back([](const int value) -> Task<int>
+        {
+            co_await Coroutine::SwitchToJobSystem();
+            co_return value * 2;
+        }(i));
+        tasks.back().Start();
+    }
+    int sum = 0;
+    for (Task<int>& item : tasks)
+        sum += item.Get();
+    ASSERT_EQ(sum, 999 * 1000);
+
+    //执行期间销毁Task时协程被分离，完成后自行销毁协程帧，参数随之析构
+    std::atomic<bool> canFinish = false;
+    std::shared_ptr<int> marker = std::make_shared<int>(0);
+    std::weak_ptr<int> weakMarker = marker;
+    {
+        Task<> detached = [](const std::shared_ptr<int> value, std::atomic<bool>& finish) -> Task<>
+        {
+            co_await Coroutine::WaitUntil([&finish] { return finish.load(); });
+            (*value)++;
+        }(std::move(marker), canFinish);
+        detached.Start();
+    }
+    ASSERT_FALSE(weakMarker.expired());
+    canFinish = true;
+    Coroutine::RunMainThread();
+    ASSERT_TRUE(weakMarker.expired());
 }
 
 TEST(Utility, Chronograph)
@@ -199,5 +882,207 @@ void main()
         }
     });
 
+    benchmark::RegisterBenchmark("JobSystem", [](benchmark::State& state)
+    {
+        JobSystem& jobSystem = JobSystem::GetDefault();
+        std::atomic<int> counter = 0;
+        for (auto _ : state)
+        {
+            for (int i = 0; i < 1000; i++)
+                jobSystem.Schedule([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            jobSystem.WaitAll();
+        }
+        state.SetItemsProcessed(state.iterations() * 1000);
+    });
+
+    benchmark::RegisterBenchmark("std::sort", [](benchmark::State& state)
+    {
+        std::mt19937 random(1);
+        std::vector<uint32_t> keys(1 << 20);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (uint32_t& key : keys)
+                key = random();
+            state.ResumeTiming();
+            std::sort(keys.begin(), keys.end());
+        }
+    });
+    benchmark::RegisterBenchmark("Parallel::Sort", [](benchmark::State& state)
+    {
+        std::mt19937 random(1);
+        std::vector<uint32_t> keys(1 << 20);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (uint32_t& key : keys)
+                key = random();
+            state.ResumeTiming();
+            Parallel::Sort(std::span(keys));
+        }
+    });
+
+    //一个生产者线程和一个消费者线程之间传递整数
+    auto registerQueueBenchmark = [](const char* name, auto createQueue)
+    {
+        benchmark::RegisterBenchmark(name, [createQueue](benchmark::State& state)
+        {
+            constexpr int count = 100000;
+            for (auto _ : state)
+            {
+                auto queue = createQueue();
+                std::jthread producer([&queue]
+                {
+                    for (int i = 0; i < count; i++)
+                        while (!queue->TryPush(i))
+                            std::this_thread::yield();
+                });
+                int value;
+                for (int i = 0; i < count;)
+                {
+                    if (queue->TryPop(value))
+                        i++;
+                    else
+                        std::this_thread::yield();
+                }
+            }
+            state.SetItemsProcessed(state.iterations() * count);
+        });
+    };
+    struct MutexQueue
+    {
+        std::mutex mutex;
+        std::queue<int> queue;
+
+        bool TryPush(const int value)
+        {
+            std::lock_guard lock(mutex);
+            queue.push(value);
+            return true;
+        }
+        bool TryPop(int& value)
+        {
+            std::lock_guard lock(mutex);
+            if (queue.empty())
+                return false;
+            value = queue.front();
+            queue.pop();
+            return true;
+        }
+    };
+    registerQueueBenchmark("MutexQueue", [] { return std::make_unique<MutexQueue>(); });
+    registerQueueBenchmark("SPSCQueue", [] { return std::make_unique<SPSCQueue<int>>(1024); });
+    registerQueueBenchmark("MPMCQueue", [] { return std::make_unique<MPMCQueue<int>>(1024); });
+
+    benchmark::RegisterBenchmark("ObjectPool", [](benchmark::State& state)
+    {
+        ObjectPool<std::array<int, 16>> objPool = {static_cast<ObjectPoolThreading>(state.range(0))};
+        std::array<std::array<int, 16>*, 64> objects;
+        for (auto _ : state)
+        {
+            for (auto& object : objects)
+                object = &objPool.Get();
+            for (auto* object : objects)
+                objPool.Release(*object);
+        }
+        state.SetItemsProcessed(state.iterations() * objects.size());
+    })->DenseRange(0, 2);
+    benchmark::RegisterBenchmark("NewDelete", [](benchmark::State& state)
+    {
+        std::array<std::array<int, 16>*, 64> objects;
+        for (auto _ : state)
+        {
+            for (auto& object : objects)
+                object = new std::array<int, 16>();
+            for (auto* object : objects)
+                delete object;
+        }
+        state.SetItemsProcessed(state.iterations() * objects.size());
+    });
+
+    //每帧大量小块临时内存，如命令参数和闭包捕获
+    benchmark::RegisterBenchmark("TransientWithHeap", [](benchmark::State& state)
+    {
+        std::array<std::unique_ptr<std::byte[]>, 256> allocations;
+        for (auto _ : state)
+        {
+            for (auto& allocation : allocations)
+                allocation = std::make_unique_for_overwrite<std::byte[]>(64);
+            benchmark::DoNotOptimize(allocations.data());
+            for (auto& allocation : allocations)
+                allocation.reset();
+        }
+        state.SetItemsProcessed(state.iterations() * allocations.size());
+    });
+    benchmark::RegisterBenchmark("TransientWithFrameArena", [](benchmark::State& state)
+    {
+        std::array<std::byte*, 256> allocations;
+        for (auto _ : state)
+        {
+            LinearArena& arena = FrameArena::GetResource();
+            for (auto& allocation : allocations)
+                allocation = static_cast<std::byte*>(arena.Allocate(64));
+            benchmark::DoNotOptimize(allocations.data());
+            FrameArena::EndFrame();
+        }
+        state.SetItemsProcessed(state.iterations() * allocations.size());
+    });
+
+    //构造并调用捕获了多个值的回调，超出std::function内联缓冲区时会分配堆内存
+    benchmark::RegisterBenchmark("StdFunction", [](benchmark::State& state)
+    {
+        int64_t sum = 0;
+        for (auto _ : state)
+        {
+            const std::function<void()> function = [&sum,a = state.iterations(),b = sum,c = &state] { sum += a + b + c->range(0); };
+            function();
+        }
+        benchmark::DoNotOptimize(sum);
+    })->Arg(1);
+    benchmark::RegisterBenchmark("InplaceFunction", [](benchmark::State& state)
+    {
+        int64_t sum = 0;
+        for (auto _ : state)
+        {
+            const InplaceFunction<void()> function = [&sum,a = state.iterations(),b = sum,c = &state] { sum += a + b + c->range(0); };
+            function();
+        }
+        benchmark::DoNotOptimize(sum);
+    })->Arg(1);
+
+    benchmark::RegisterBenchmark("Logger", [](benchmark::State& state)
+    {
+        Logger::SetConsoleOutput(false);
+        int count = 0;
+        for (auto _ : state)
+        {
+            LIGHT_LOG_INFO(TestLog, "Frame:{} Value:{:.3f} Name:{}", count, 0.5, "Entity");
+            //避免队列写满，格式化和输出由后台线程负责，不计入调用线程的耗时
+            if (++count % 512 == 0)
+            {
+                state.PauseTiming();
+                Logger::Flush();
+                state.ResumeTiming();
+            }
+        }
+        Logger::Flush();
+        Logger::SetConsoleOutput(true);
+    });
+
+    benchmark::RegisterBenchmark("ProfileZone", [](benchmark::State& state)
+    {
+        Profiler::BeginCapture();
+        int count = 0;
+        for (auto _ : state)
+        {
+            LIGHT_PROFILE_ZONE("Zone");
+            if (++count % 1024 == 0)
+                LIGHT_PROFILE_FRAME();
+        }
+        Profiler::EndCapture();
+        Profiler::BeginCapture();
+        Profiler::EndCapture();
+    });
+
     benchmark::RunSpecifiedBenchmarks();
 }
@@ -36,33 +36,33 @@ bool Window::GetFullScreen()
     return glfwGetWindowMonitor(glfwWindow) != nullptr;
 }
 
-void Window::SetWindowStartEvent(const std::function<void()>& windowStartEvent)
+void Window::SetWindowStartEvent(InplaceFunction<void()> windowStartEvent)
 {
     if (windowStartEvent == nullptr)
         throw std::exception("事件为空");
 
-    Window::windowStartEvent = windowStartEvent;
+    Window::windowStartEvent = std::move(windowStartEvent);
 }
-void Window::SetWindowStopEvent(const std::function<void()>& windowStopEvent)
+void Window::SetWindowStopEvent(InplaceFunction<void()> windowStopEvent)
 {
     if (windowStopEvent == nullptr)
         throw std::exception("事件为空");
 
-    Window::windowStopEvent = windowStopEvent;
+    Window::windowStopEvent = std::move(windowStopEvent);
 }
-void Window::SetWindowUpdateEvent(const std::function<void()>& windowUpdateEvent)
+void Window::SetWindowUpdateEvent(InplaceFunction<void()> windowUpdateEvent)
 {
     if (windowUpdateEvent == nullptr)
         throw std::exception("事件为空");
 
-    Window::windowUpdateEvent = windowUpdateEvent;
+    Window::windowUpdateEvent = std::move(windowUpdateEvent);
 }
-void Window::SetWindowStopConfirm(const std::function<bool()>& windowStopConfirm)
+void Window::SetWindowStopConfirm(InplaceFunction<bool()> windowStopConfirm)
 {
     if (windowStopConfirm == nullptr)
         throw std::exception("事件为空");
 
-    Window::windowStopConfirm = windowStopConfirm;
+    Window::windowStopConfirm = std::move(windowStopConfirm);
 }
 void Window::SetFullScreen(const bool fullscreen)
 {
@@ -1,8 +1,8 @@
 ﻿#pragma once
-#include <functional>
 #include <GLFW/glfw3.h>
 
 #include "LightMath/Runtime/Vector.hpp"
+#include "LightUtility/Runtime/InplaceFunction.hpp"
 
 namespace Light
 {
@@ -21,10 +21,10 @@ namespace Light
         static int2 GetResolution();
         static bool GetFullScreen();
         static GLFWwindow* GetGlfwWindow() { return glfwWindow; }
-        static void SetWindowStartEvent(const std::function<void()>& windowStartEvent);
-        static void SetWindowStopEvent(const std::function<void()>& windowStopEvent);
-        static void SetWindowUpdateEvent(const std::function<void()>& windowUpdateEvent);
-        static void SetWindowStopConfirm(const std::function<bool()>& windowStopConfirm);
+        static void SetWindowStartEvent(InplaceFunction<void()> windowStartEvent);
+        static void SetWindowStopEvent(InplaceFunction<void()> windowStopEvent);
+        static void SetWindowUpdateEvent(InplaceFunction<void()> windowUpdateEvent);
+        static void SetWindowStopConfirm(InplaceFunction<bool()> windowStopConfirm);
         static void SetResolution(int width, int height);
         static void SetFullScreen(bool fullscreen);
 
@@ -39,16 +39,16 @@ namespace Light
 
     private:
         inline static GLFWwindow* glfwWindow;
-        inline static std::function<void()> windowStartEvent = []
+        inline static InplaceFunction<void()> windowStartEvent = []
         {
         };
-        inline static std::function<void()> windowUpdateEvent = []
+        inline static InplaceFunction<void()> windowUpdateEvent = []
         {
         };
-        inline static std::function<void()> windowStopEvent = []
+        inline static InplaceFunction<void()> windowStopEvent = []
         {
         };
-        inline static std::function<bool()> windowStopConfirm = [] { return true; };
+        inline static InplaceFunction<bool()> windowStopConfirm = [] { return true; };
 
         Window() = default;
     };